@@ -0,0 +1,29 @@
+#pragma once
+
+// Time graphs see as t, advanced from the wall clock once per drawn frame
+// instead of following the display refresh.
+class AnimationClock {
+ public:
+  bool isPlaying = true;
+  float speed = 1.0f;
+  // Animation frames per second, t is held between steps. 0 steps with every
+  // drawn frame.
+  float stepRate = 0.0f;
+
+  // Advances by the scaled wall clock time since the last update.
+  void update(double now);
+
+  // Moves one step forward, 1/60 s if the step rate is 0.
+  void step();
+
+  void reset();
+
+  float getTime() const;
+
+  // t holds still over several drawn frames, so frames can be reused.
+  bool isStepped() const;
+
+ private:
+  double time = 0.0;
+  double lastUpdate = -1.0;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SGC/opengl.hpp>
+#include <SGC/view.hpp>
+
+// std140 layout of the Camera uniform block, bound at cameraUniformBinding.
+// The engine pushes it through the uniform ring once per drawn view, every
+// program that places or evaluates graphs reads the camera from it.
+struct CameraUniforms {
+  GLfloat windowSize[2];
+  GLfloat position[2];
+  GLfloat jitter[2];
+  // Bottom left pixel of the view in the framebuffer.
+  GLint origin[2];
+  GLfloat zoom;
+  GLfloat t;
+  GLfloat parameter;
+  // std140 rounds the block size up to 16 bytes.
+  GLfloat padding;
+};
+
+constexpr GLuint cameraUniformBinding = 1;
+
+// Declares the block, its members are the globals windowSize, position,
+// jitter, origin, zoom, t and a. A literal, so shader sources of other
+// translation units can be built from it during static initialization.
+constexpr const GLchar* cameraBlockSource =          //
+    "layout (std140, binding = 1) uniform Camera {"  //
+    "  vec2 windowSize;"                             //
+    "  vec2 position;"                               //
+    "  vec2 jitter;"                                 //
+    "  ivec2 origin;"                                //
+    "  float zoom;"                                  //
+    "  float t;"                                     //
+    "  float a;"                                     //
+    "};";
+
+CameraUniforms makeCameraUniforms(const View& view);
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SGC/graph.hpp>
+#include <SGC/opengl.hpp>
+#include <SGC/view.hpp>
+#include <vector>
+
+// Functional graphs evaluated once per pixel column by a compute shader. Every
+// column stores the screen y ranges the curve covers across its sub-samples,
+// two of them so an asymptote inside the column is not filled. The composite
+// pass only compares the pixel against these ranges.
+class ColumnRenderer {
+ public:
+  static constexpr int subSamples = 4;
+
+  ColumnRenderer() = default;
+  ColumnRenderer(const ColumnRenderer&) = delete;
+  ColumnRenderer& operator=(const ColumnRenderer&) = delete;
+  ColumnRenderer(ColumnRenderer&&) = delete;
+  ColumnRenderer& operator=(ColumnRenderer&&) = delete;
+
+  ~ColumnRenderer();
+
+  // Compiles a program for every visible column constant graph. Returns false
+  // and keeps the previous graphs if one fails.
+  bool setGraphs(const std::vector<Graph>& graphs);
+
+  // Evaluates the columns and composites over the bound framebuffer, earlier
+  // graphs on top, with the camera of the bound Camera block.
+  void draw(const View& view);
+
+  void release();
+
+ private:
+  struct Column {
+    GLuint program = 0;
+  };
+
+  GLuint compositeProgram = 0;
+  GLuint vertexArray = 0;
+  GLuint rangesBuffer = 0;
+  GLsizeiptr rangesBufferSize = 0;
+  GLuint stylesBuffer = 0;
+  std::vector<Column> columns;
+  std::vector<GLfloat> styles;
+
+  void releaseColumns();
+};
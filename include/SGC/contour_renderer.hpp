@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SGC/graph.hpp>
+#include <SGC/opengl.hpp>
+#include <vector>
+
+// Contour graphs drawn by one fullscreen program each. The body is evaluated
+// once per pixel and every level is tested against it, the line width in
+// world units follows the screen gradient of the value. Levels, color and
+// thickness are set on the program when they change, so only a new body
+// compiles.
+class ContourRenderer {
+ public:
+  static constexpr int maxLevels = 64;
+
+  ContourRenderer() = default;
+  ContourRenderer(const ContourRenderer&) = delete;
+  ContourRenderer& operator=(const ContourRenderer&) = delete;
+  ContourRenderer(ContourRenderer&&) = delete;
+  ContourRenderer& operator=(ContourRenderer&&) = delete;
+
+  ~ContourRenderer();
+
+  // Compiles a program for every visible contour graph. Returns false and
+  // keeps the previous graphs if one fails.
+  bool setGraphs(const std::vector<Graph>& graphs);
+
+  // Sets the levels, colors and thicknesses of the graphs set last on their
+  // programs, without compiling.
+  void setStyles(const std::vector<Graph>& graphs);
+
+  // Blends the contours over the bound framebuffer, earlier graphs on top,
+  // with the camera of the bound Camera block.
+  void draw();
+
+  void release();
+
+ private:
+  struct Contour {
+    GLuint program = 0;
+    GLsizei levelCount = 0;
+  };
+
+  std::vector<Contour> contours;
+  GLuint vertexArray = 0;
+
+  void releaseContours();
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SGC/graph.hpp>
+#include <SGC/opengl.hpp>
+#include <SGC/view.hpp>
+#include <string>
+#include <vector>
+
+// Functional graphs as anti-aliased line strips. y = f(x) is evaluated in the
+// vertex shader a few times per pixel column and every segment is expanded to
+// a screen-space quad, so a curve costs O(width) and steep parts stay
+// connected.
+class CurveRenderer {
+ public:
+  static constexpr int samplesPerPixel = 2;
+
+  CurveRenderer() = default;
+  CurveRenderer(const CurveRenderer&) = delete;
+  CurveRenderer& operator=(const CurveRenderer&) = delete;
+  CurveRenderer(CurveRenderer&&) = delete;
+  CurveRenderer& operator=(CurveRenderer&&) = delete;
+
+  ~CurveRenderer();
+
+  // Compiles a program for every visible column constant graph. Returns false
+  // and keeps the previous curves if one fails.
+  bool setGraphs(const std::vector<Graph>& graphs);
+
+  // Blends the curves over the bound framebuffer, earlier graphs on top, with
+  // the camera of the bound Camera block.
+  void draw(const View& view);
+
+  void release();
+
+ private:
+  struct Curve {
+    GLuint program = 0;
+  };
+
+  GLuint vertexArray = 0;
+  std::vector<Curve> curves;
+
+  void releaseCurves();
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SGC/graph.hpp>
+#include <SGC/opengl.hpp>
+#include <SGC/view.hpp>
+#include <vector>
+
+// Per pixel graphs shaded by two compute passes. The first shades one sample
+// per pixel and appends pixels whose 3x3 neighbourhood changes color, or the
+// side of a functional curve, to a list. The second runs a grid of samples
+// only on the listed pixels, dispatched indirectly with the list length.
+class EdgeSupersampler {
+ public:
+  static constexpr int samplesPerAxis = 4;
+
+  EdgeSupersampler() = default;
+  EdgeSupersampler(const EdgeSupersampler&) = delete;
+  EdgeSupersampler& operator=(const EdgeSupersampler&) = delete;
+  EdgeSupersampler(EdgeSupersampler&&) = delete;
+  EdgeSupersampler& operator=(EdgeSupersampler&&) = delete;
+
+  ~EdgeSupersampler();
+
+  // Compiles the passes for the graphs. Returns false and keeps the previous
+  // graphs if one fails.
+  bool setGraphs(const std::vector<Graph>& graphs);
+
+  // Shades the graphs and blends them over the bound framebuffer, with the
+  // camera of the bound Camera block.
+  void draw(const View& view);
+
+  void release();
+
+ private:
+  GLuint markProgram = 0;
+  GLuint supersampleProgram = 0;
+  GLuint compositeProgram = 0;
+  GLuint vertexArray = 0;
+  GLuint edgesBuffer = 0;
+  GLsizeiptr edgesBufferSize = 0;
+  GLuint layerTexture = 0;
+  int layerWidth = 0;
+  int layerHeight = 0;
+
+  void releasePrograms();
+};
@@ -9,6 +9,7 @@ enum class SGCErrorType : int {
   GLFW_ERROR,
   GLAD_ERROR,
   OPENGL_ERROR,
+  EXPRESSION_ERROR,
 };
 
 class SGCError : std::exception {
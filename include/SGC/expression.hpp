@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class OpCode : std::uint8_t {
+  PUSH_X,
+  PUSH_Y,
+  PUSH_PS,
+  PUSH_T,
+  PUSH_CONST,
+  ADD,
+  SUB,
+  MUL,
+  DIV,
+  NEG,
+  NOT,
+  AND,
+  OR,
+  LESS,
+  LESS_EQUAL,
+  GREATER,
+  GREATER_EQUAL,
+  EQUAL,
+  NOT_EQUAL,
+  ABS,
+  SQRT,
+  SIN,
+  COS,
+  TAN,
+  COT,
+  EXP,
+  LOG,
+  POW,
+  IS_EQUAL_APPROX,
+};
+
+struct Instruction {
+  OpCode op;
+  float value = 0.0f;
+
+  bool operator==(const Instruction& other) const = default;
+};
+
+struct EvaluationInput {
+  const float* x;
+  const float* y;
+  float ps;
+  float t;
+  std::size_t count;
+};
+
+// CPU version of a graph body. The body is parsed into postfix bytecode and
+// evaluated over batches of lanes, booleans are stored as 1.0 and 0.0.
+class Expression {
+ public:
+  static constexpr std::size_t batchSize = 64;
+
+  // Throws SGCError if the body is not supported on CPU.
+  explicit Expression(const std::string& source);
+
+  const std::vector<Instruction>& getInstructions() const;
+
+  std::size_t getMaxStackDepth() const;
+
+  std::size_t hash() const;
+
+  bool isBoolean() const;
+
+  bool usesX() const;
+
+  bool usesY() const;
+
+  bool usesTime() const;
+
+  void evaluate(const EvaluationInput& input, float* out) const;
+
+ private:
+  std::vector<Instruction> instructions;
+  std::size_t maxStackDepth = 0;
+  bool resultIsBoolean = false;
+};
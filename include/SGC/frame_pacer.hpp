@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SGC/opengl.hpp>
+#include <cstddef>
+#include <deque>
+
+// Fences every presented frame to limit how many frames the driver queues
+// ahead of the GPU. A timestamp query after the frame measures the time from
+// the first input the frame uses to the GPU finishing it.
+class FramePacer {
+ public:
+  // Frames older than this are dropped unmeasured.
+  static constexpr std::size_t maxPendingFrames = 4;
+
+  // Waits for every frame before the next one samples input.
+  bool isLowLatency = false;
+
+  FramePacer() = default;
+  FramePacer(const FramePacer&) = delete;
+  FramePacer& operator=(const FramePacer&) = delete;
+  FramePacer(FramePacer&&) = delete;
+  FramePacer& operator=(FramePacer&&) = delete;
+
+  ~FramePacer();
+
+  // Input the next frame will use, only the earliest time of a frame counts.
+  void addInput(double time);
+
+  // Before input is sampled for a new frame.
+  void beginFrame();
+
+  // After the swap of the frame.
+  void endFrame();
+
+  // Smoothed input to GPU completion time in milliseconds.
+  float getLatency() const;
+
+  void release();
+
+ private:
+  struct PendingFrame {
+    GLsync fence;
+    GLuint timestampQuery;
+    double inputTime;
+    // CPU and GPU clocks at the end of the frame, to convert the timestamp.
+    double submitTime;
+    GLint64 gpuSubmitTime;
+  };
+
+  std::deque<PendingFrame> pendingFrames;
+  double inputTime = -1.0;
+  float latency = 0.0f;
+
+  void retireFrames(bool shouldWait);
+
+  static void deleteFrame(const PendingFrame& frame);
+};
@@ -1,9 +1,38 @@
 #pragma once
 
 #include <string>
+#include <vector>
+
+enum class GraphType : int {
+  // Functional or equational, see isFunctional.
+  PLAIN,
+  // The body is a float field shown through a colormap.
+  HEATMAP,
+  // Lines where the float body is one of the levels.
+  CONTOUR,
+  // Arrows along the vec2 body, written as u, v.
+  VECTOR_FIELD,
+  // Solution curves through the seeds of dy/dx or of the system u, v.
+  ODE,
+};
+
+enum class OdeMethod : int {
+  RK4,
+  // Dormand-Prince 5(4) with step size control.
+  RK45,
+};
+
+enum class Colormap : int {
+  VIRIDIS,
+  TURBO,
+  // Diverging, centered on 0.
+  COOLWARM,
+  GRAYSCALE,
+};
 
 class Graph {
  public:
+  GraphType type = GraphType::PLAIN;
   bool isFunctional;
   std::string name;
   std::string body;
@@ -13,9 +42,39 @@ class Graph {
   float b;
   float thickness;
   bool isVisible = true;
+  Colormap colormap = Colormap::VIRIDIS;
+  std::vector<float> levels;
+  // x, y pairs.
+  std::vector<float> seeds;
+  OdeMethod odeMethod = OdeMethod::RK4;
 
   Graph(bool isFunctional, std::string name, std::string body, float r, float g, float b,
         float thickness);
   
   std::string getGraphShaderPart() const;
+
+  // Blends the graph into result with analytic anti-aliasing. The coverage is
+  // the distance to the curve from the value and its screen gradient, for
+  // functional graphs, isEqualApprox and single comparisons. Other equations
+  // are drawn with hard edges.
+  std::string getCoverageShaderPart() const;
+
+  // Float whose sign changes across the curve, band center or region border
+  // of the graph, empty for other equations.
+  std::string getBoundaryValue() const;
+
+  // Full width of an isEqualApprox band in units of the boundary value, empty
+  // for other graphs.
+  std::string getBandWidth() const;
+
+  bool usesTime() const;
+
+  bool usesY() const;
+
+  // Reads the parameter a, which only the per pixel shader provides.
+  bool usesParameter() const;
+
+  // Plain, functional and independent of the pixel y and a, so one value per
+  // column.
+  bool isColumnConstant() const;
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <SGC/expression.hpp>
+#include <SGC/graph.hpp>
+#include <SGC/opengl.hpp>
+#include <SGC/view.hpp>
+#include <memory>
+#include <vector>
+
+// Per pixel graphs drawn one program each instead of the fused if/else chain.
+// Every pass is scissored to the screen rectangle interval analysis on the
+// CPU cannot rule out, so pixels no graph touches cost only the grid.
+class GraphPasses {
+ public:
+  // Cells of this many pixels or less are not split further.
+  static constexpr int minCellSize = 16;
+
+  GraphPasses() = default;
+  GraphPasses(const GraphPasses&) = delete;
+  GraphPasses& operator=(const GraphPasses&) = delete;
+  GraphPasses(GraphPasses&&) = delete;
+  GraphPasses& operator=(GraphPasses&&) = delete;
+
+  ~GraphPasses();
+
+  // Compiles a program for every graph, with coverage parts if
+  // isCoverageShading. Returns false and keeps the previous passes if one
+  // fails.
+  bool setGraphs(const std::vector<Graph>& graphs, bool isCoverageShading);
+
+  // Blends the passes over the bound framebuffer in layer order, earlier
+  // graphs on top. Draws one instance of the quad of the bound vertex array
+  // per view, with the bound Frame uniform block.
+  void draw(const std::vector<View>& views);
+
+  void release();
+
+  // Share of the views inside the scissor rectangles in the last draw,
+  // summed over the passes.
+  float getCoverage() const;
+
+ private:
+  struct PixelRect {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+
+    bool isEmpty() const;
+    PixelRect intersect(const PixelRect& other) const;
+    PixelRect unite(const PixelRect& other) const;
+  };
+
+  struct Pass {
+    GLuint program;
+    // Null if the body is not supported on CPU, the pass is never clipped.
+    std::shared_ptr<const Expression> expression;
+    bool isFunctional;
+    float thickness;
+  };
+
+  std::vector<Pass> passes;
+  float coverage = 0.0f;
+
+  bool mayCover(const Pass& pass, const View& view,
+                const PixelRect& cell) const;
+
+  void addBounds(const Pass& pass, const View& view, const PixelRect& cell,
+                 PixelRect& bounds) const;
+
+  PixelRect getBounds(const Pass& pass, const View& view) const;
+
+  void releasePasses();
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SGC/opengl.hpp>
+#include <string>
+
+// Fullscreen program that tests graphs per pixel. The fragment shader is the
+// start, the parts from Graph::getGraphShaderPart and the end, or the coverage
+// start, the parts from Graph::getCoverageShaderPart and the coverage end.
+extern const std::string vertexShaderSource;
+
+// Views one draw covers, one instance of the quad each.
+constexpr int maxFrameViews = 4;
+
+// Per instance attributes of a parameter sweep, the cell rectangle in
+// normalized device coordinates and the value of a in the cell.
+constexpr GLuint cellRectAttribute = 1;
+constexpr GLuint cellParameterAttribute = 2;
+
+// std140 layouts of the Frame uniform block, bound at frameUniformBinding.
+struct ViewUniforms {
+  // Rectangle of the view in normalized device coordinates.
+  GLfloat rect[4];
+  GLfloat windowSize[2];
+  GLfloat position[2];
+  GLfloat jitter[2];
+  GLfloat zoom;
+  GLfloat t;
+  GLfloat parameter;
+  // std140 rounds the array stride up to 16 bytes.
+  GLfloat padding[3];
+};
+
+struct FrameUniforms {
+  ViewUniforms views[maxFrameViews];
+  GLint sampleStep;
+  GLint skipStep;
+  // Instances are cells of the first view if not 0.
+  GLint cellCount;
+  // std140 rounds the block size up to 16 bytes.
+  GLint padding;
+};
+
+constexpr GLuint frameUniformBinding = 0;
+
+extern const std::string fragmentShaderSourceStart;
+
+extern const std::string fragmentShaderSourceEnd;
+
+extern const std::string coverageFragmentShaderSourceStart;
+
+extern const std::string coverageFragmentShaderSourceEnd;
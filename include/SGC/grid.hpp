@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SGC/opengl.hpp>
+#include <SGC/view.hpp>
+#include <vector>
+
+// Background, microlines, sublines and axes of a view as GL_LINES geometry,
+// drawn before the graphs so the two passes never add to each other's cost.
+class Grid {
+ public:
+  Grid() = default;
+  Grid(const Grid&) = delete;
+  Grid& operator=(const Grid&) = delete;
+  Grid(Grid&&) = delete;
+  Grid& operator=(Grid&&) = delete;
+
+  ~Grid();
+
+  // Clears the bound framebuffer to the background and draws the lines.
+  void draw(const View& view);
+
+  void release();
+
+ private:
+  GLuint vertexArray = 0;
+  GLuint vertexBuffer = 0;
+  GLsizeiptr vertexBufferSize = 0;
+  GLuint program = 0;
+  GLint colorUniformLocation = 0;
+  std::vector<GLfloat> vertices;
+
+  void addLines(const View& view, float period, bool isVertical);
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SGC/graph.hpp>
+#include <SGC/opengl.hpp>
+#include <SGC/view.hpp>
+#include <vector>
+
+// Heatmap graphs evaluated once per pixel by a compute shader that also
+// reduces the value range of its work group. A second pass reduces the group
+// ranges to the range of the view, which the composite pass reads from the
+// buffer to normalize values into a 1D colormap, so the range never goes
+// through the CPU.
+class HeatmapRenderer {
+ public:
+  static constexpr int colormapSize = 256;
+  static constexpr float opacity = 0.85f;
+
+  HeatmapRenderer() = default;
+  HeatmapRenderer(const HeatmapRenderer&) = delete;
+  HeatmapRenderer& operator=(const HeatmapRenderer&) = delete;
+  HeatmapRenderer(HeatmapRenderer&&) = delete;
+  HeatmapRenderer& operator=(HeatmapRenderer&&) = delete;
+
+  ~HeatmapRenderer();
+
+  // Compiles a program for every visible heatmap graph. Returns false and
+  // keeps the previous graphs if one fails.
+  bool setGraphs(const std::vector<Graph>& graphs);
+
+  // Blends the heatmaps over the bound framebuffer, later graphs on top, with
+  // the camera of the bound Camera block.
+  void draw(const View& view);
+
+  bool isEmpty() const;
+
+  void release();
+
+ private:
+  struct Heatmap {
+    GLuint program = 0;
+    Colormap colormap = Colormap::VIRIDIS;
+  };
+
+  std::vector<Heatmap> heatmaps;
+  GLuint reduceProgram = 0;
+  GLint reduceGroupCountUniformLocation = 0;
+  GLint reduceRangeIndexUniformLocation = 0;
+  GLuint compositeProgram = 0;
+  GLint compositeRangeIndexUniformLocation = 0;
+  GLint compositeColormapUniformLocation = 0;
+  GLint compositeIsDivergingUniformLocation = 0;
+  GLuint vertexArray = 0;
+  GLuint colormapTexture = 0;
+  GLuint valuesTexture = 0;
+  int valuesWidth = 0;
+  int valuesHeight = 0;
+  GLuint groupRangesBuffer = 0;
+  GLsizeiptr groupRangesBufferSize = 0;
+  GLuint rangesBuffer = 0;
+  GLsizeiptr rangesBufferSize = 0;
+
+  void create();
+
+  void releaseHeatmaps();
+};
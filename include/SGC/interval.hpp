@@ -0,0 +1,26 @@
+#pragma once
+
+#include <SGC/expression.hpp>
+
+// Range of values an expression can take over a box of inputs. Booleans are
+// subranges of [0, 1], an empty interval (lo > hi) means no defined value.
+// mayBeNaN marks inputs where the body is undefined, which comparisons treat
+// as false like the shader does.
+struct Interval {
+  double lo;
+  double hi;
+  bool mayBeNaN = false;
+
+  bool isEmpty() const;
+};
+
+struct IntervalInput {
+  Interval x;
+  Interval y;
+  float ps;
+  float t;
+};
+
+// Conservative bounds: every value the body takes over the box is inside.
+Interval evaluateInterval(const Expression& expression,
+                          const IntervalInput& input);
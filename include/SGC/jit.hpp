@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SGC/expression.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Expression compiled to native x86-64 AVX2 code. Falls back to the batch
+// interpreter when the expression, architecture or CPU is not supported.
+class CompiledExpression {
+ public:
+  static constexpr std::size_t laneCount = 8;
+
+  CompiledExpression(const CompiledExpression&) = delete;
+  CompiledExpression& operator=(const CompiledExpression&) = delete;
+  CompiledExpression(CompiledExpression&&) = delete;
+  CompiledExpression& operator=(CompiledExpression&&) = delete;
+
+  explicit CompiledExpression(Expression source);
+
+  ~CompiledExpression();
+
+  const Expression& getExpression() const;
+
+  bool isNative() const;
+
+  void evaluate(const EvaluationInput& input, float* out) const;
+
+ private:
+  using Kernel = void (*)(float* frame);
+
+  Expression expression;
+  void* code = nullptr;
+  std::size_t codeSize = 0;
+  Kernel kernel = nullptr;
+
+  bool compile();
+};
+
+// Parses and compiles the body, reusing code cached by expression hash. The
+// cache is bounded, code is freed with the last expression using it.
+// Throws SGCError if the body is not supported on CPU.
+std::shared_ptr<const CompiledExpression> compileExpression(
+    const std::string& source);
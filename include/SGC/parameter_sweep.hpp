@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SGC/opengl.hpp>
+#include <SGC/view.hpp>
+#include <vector>
+
+// Grid of small copies of a view with values of the graph parameter a spread
+// over a range. The cells are instances of one draw of the graph programs,
+// their rectangles and values come from an instance buffer.
+class ParameterSweep {
+ public:
+  static constexpr int maxCellsPerAxis = 16;
+
+  int columns = 8;
+  int rows = 8;
+  float from = 0.5f;
+  float to = 8.0f;
+
+  ParameterSweep() = default;
+  ParameterSweep(const ParameterSweep&) = delete;
+  ParameterSweep& operator=(const ParameterSweep&) = delete;
+  ParameterSweep(ParameterSweep&&) = delete;
+  ParameterSweep& operator=(ParameterSweep&&) = delete;
+
+  ~ParameterSweep();
+
+  // Cells row by row from the top left, each shows the world rectangle of the
+  // view scaled to the cell. All cells have the same size.
+  std::vector<View> makeCells(const View& view) const;
+
+  // Sets the cells as per instance attributes of the bound vertex array, with
+  // rectangles relative to the bound viewport.
+  void bindCells(const std::vector<View>& cells);
+
+  // Disables the per instance attributes of the bound vertex array.
+  void unbindCells();
+
+  void release();
+
+ private:
+  GLuint instanceBuffer = 0;
+  std::vector<GLfloat> instances;
+};
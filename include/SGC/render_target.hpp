@@ -0,0 +1,31 @@
+#pragma once
+
+#include <SGC/opengl.hpp>
+
+// Framebuffer with a single color texture.
+class RenderTarget {
+ public:
+  GLuint framebuffer = 0;
+  GLuint texture = 0;
+  int width = 0;
+  int height = 0;
+
+  RenderTarget() = default;
+  RenderTarget(const RenderTarget&) = delete;
+  RenderTarget& operator=(const RenderTarget&) = delete;
+  RenderTarget(RenderTarget&&) = delete;
+  RenderTarget& operator=(RenderTarget&&) = delete;
+
+  ~RenderTarget();
+
+  // Reallocates the texture if the size or format changed, returns true if
+  // the content was lost.
+  bool resize(int newWidth, int newHeight, GLenum newFormat = GL_RGBA8);
+
+  void release();
+
+  void bind() const;
+
+ private:
+  GLenum internalFormat = GL_RGBA8;
+};
@@ -2,14 +2,58 @@
 
 #include <SGC/opengl.hpp>
 #include <imgui.h>
+#include <memory>
 #include <vector>
+#include <SGC/animation_clock.hpp>
+#include <SGC/camera_block.hpp>
+#include <SGC/column_renderer.hpp>
+#include <SGC/contour_renderer.hpp>
+#include <SGC/curve_renderer.hpp>
+#include <SGC/edge_supersampler.hpp>
+#include <SGC/frame_pacer.hpp>
 #include <SGC/graph.hpp>
+#include <SGC/graph_passes.hpp>
+#include <SGC/graph_shader.hpp>
+#include <SGC/grid.hpp>
+#include <SGC/heatmap_renderer.hpp>
+#include <SGC/parameter_sweep.hpp>
+#include <SGC/render_target.hpp>
+#include <SGC/software_renderer.hpp>
+#include <SGC/tile_cache.hpp>
+#include <SGC/trajectory_renderer.hpp>
+#include <SGC/uniform_ring.hpp>
+#include <SGC/vector_field_renderer.hpp>
+#include <SGC/view.hpp>
+
+enum class RenderBackend : int {
+  OPENGL,
+  SOFTWARE,
+};
+
+// How graphs with one y per x are drawn, graphs reading y are always tested
+// per pixel.
+enum class FunctionalGraphMode : int {
+  PIXELS,
+  CURVES,
+  COLUMNS,
+};
+
+// Camera of a split view, t is offset from the animation time.
+struct SplitCamera {
+  GLfloat positionX = 0.0f;
+  GLfloat positionY = 0.0f;
+  GLfloat zoom = 200.0f;
+  GLfloat timeOffset = 0.0f;
+};
 
 class SGCEngine {
  private:
   GLFWwindow* window = nullptr;
   GLuint displayVAO = 0;
   GLuint shaderProgram = 0;
+  GLuint textureProgram = 0;
+  GLuint resolveProgram = 0;
+  GLuint softwareTexture = 0;
 
   int windowWidth = 800;
   int windowHeight = 800;
@@ -19,23 +63,180 @@ class SGCEngine {
 
   GLfloat zoom = 200.0;
 
-  GLint windowSizeUniformLocation = 0;
-  GLint positionUniformLocation = 0;
-  GLint zoomUniformLocation = 0;
-  GLint sublinePeriodUniformLocation = 0;
-  GLint microlinePeriodUniformLocation = 0;
-  GLint timeUniformLocation = 0;
+  GLint textureDestRectUniformLocation = 0;
+  GLint textureSourceRectUniformLocation = 0;
+  GLint resolveSampleStepUniformLocation = 0;
+
+  Grid grid;
+
+  FunctionalGraphMode functionalGraphMode = FunctionalGraphMode::PIXELS;
+  CurveRenderer curveRenderer;
+  ColumnRenderer columnRenderer;
+  HeatmapRenderer heatmapRenderer;
+  ContourRenderer contourRenderer;
+  VectorFieldRenderer vectorFieldRenderer;
+  TrajectoryRenderer trajectoryRenderer;
+
+  bool isCoverageShading = false;
+
+  bool isGraphPasses = false;
+  GraphPasses graphPasses;
+
+  bool isEdgeSupersampling = false;
+  EdgeSupersampler edgeSupersampler;
+  RenderTarget supersampledTarget;
+  View supersampledView;
+  std::size_t supersampledRevision = 0;
+
+  bool isTemporalAccumulation = false;
+  int accumulationFrameCount = 16;
+  int accumulatedFrames = 0;
+  RenderTarget accumulationTarget;
+  RenderTarget jitteredTarget;
+  View accumulationView;
+  std::size_t accumulationRevision = 0;
+
+  AnimationClock animationClock;
+
+  // The first split view follows the main camera, the others have their own.
+  int splitViewCount = 1;
+  SplitCamera splitCameras[maxFrameViews - 1];
+
+  // Value of the graph parameter a outside the sweep.
+  float parameter = 1.0f;
+  bool isParameterSweep = false;
+  ParameterSweep parameterSweep;
+
+  FramePacer framePacer;
+  UniformRing uniformRing;
+  int swapInterval = 1;
 
   std::vector<Graph> graphs;
+  std::size_t graphsRevision = 0;
+  std::size_t graphsHash = 0;
+  std::size_t graphSourcesHash = 0;
+
+  RenderBackend renderBackend = RenderBackend::OPENGL;
+  std::unique_ptr<SoftwareRenderer> softwareRenderer;
+  std::size_t softwareGraphsRevision = 0;
+  int softwareTextureWidth = 0;
+  int softwareTextureHeight = 0;
+
+  bool isOnDemandRendering = true;
+  int redrawFrames = 1;
+  View lastDrawnView;
+  std::size_t lastDrawnGraphsRevision = 0;
+  std::size_t skippedFrames = 0;
+  std::size_t drawnFramesInSecond = 0;
+  double frameRateMeasureStart = 0.0;
+  float drawnFrameRate = 0.0f;
+
+  bool isGraphLayerCaching = true;
+  RenderTarget graphLayers[2];
+  int graphLayerIndex = 0;
+  View graphLayerView;
+  std::size_t graphLayerRevision = 0;
+
+  bool isProgressiveRendering = false;
+  RenderTarget progressiveTarget;
+  View progressiveView;
+  std::size_t progressiveRevision = 0;
+  int progressiveStep = 1;
+
+  bool isTileCaching = false;
+  TileCache tileCache;
+
+  // Overview of a wider area, shaded at a low resolution and kept until the
+  // graphs change or the view leaves it.
+  bool isMinimap = false;
+  int minimapResolution = 96;
+  float minimapExtent = 8.0f;
+  RenderTarget minimapTarget;
+  View minimapView;
+  std::size_t minimapRevision = 0;
+
+  bool isDynamicResolution = false;
+  float targetFrameTime = 16.6f;
+  float resolutionScale = 1.0f;
+  float drawnResolutionScale = 1.0f;
+  float graphPassTime = 0.0f;
+  RenderTarget scaledTarget;
+  GLuint timerQueries[3] = {};
+  int timerQueryPixels[3] = {};
+  int timerQueryIndex = 0;
 
   bool makeShaderProgram();
 
+  // Takes new contour levels, ODE seeds and methods, colors and thicknesses
+  // without compiling.
+  void updateGraphStyles();
+
+  std::size_t getGraphStylesHash() const;
+
+  bool needsContinuousRedraw() const;
+
+  bool needsRedraw() const;
+
+  bool isAnimated() const;
+
+  View makeView() const;
+
   void process();
 
   void processGUI();
 
   void draw();
 
+  // Grid, heatmaps, per pixel graphs, contours, curves and columns into the
+  // bound framebuffer.
+  void drawScene(const View& view);
+
+  // Binds the camera of the view for the layer renderers.
+  void pushCamera(const View& view);
+
+  void drawGraphs(const View& view, int sampleStep = 1, int skipStep = 0);
+
+  // One instance per view, views are placed by their origin in the bound
+  // viewport.
+  void drawGraphs(const std::vector<View>& views, int sampleStep = 1,
+                  int skipStep = 0);
+
+  // One instance per cell of a parameter sweep.
+  void drawSweptGraphs(const std::vector<View>& cells);
+
+  // Draws the quad of the bound vertex array once per view with the pushed
+  // Frame uniforms.
+  void drawGraphInstances(const std::vector<View>& views);
+
+  std::vector<View> makeSplitViews() const;
+
+  // Split views, or the cells of a parameter sweep if areCells.
+  void drawSplitScene(const std::vector<View>& views, bool areCells = false);
+
+  void drawSweepScene(const View& view);
+
+  void drawProgressive(const View& view);
+
+  void drawCachedGraphLayer(const View& view);
+
+  void drawTiledGraphs(const View& view);
+
+  void drawScaledGraphs(const View& view);
+
+  void updateResolutionScale();
+
+  void drawSupersampledScene(const View& view);
+
+  void drawAccumulatedScene(const View& view);
+
+  void drawSoftware(const View& view);
+
+  // Blends the minimap and the view rectangle over the bottom right corner.
+  void drawMinimap(const View& view);
+
+  void drawTexture(GLuint texture, const Rect& destRect,
+                   const Rect& sourceRect);
+
  public:
   SGCEngine(const SGCEngine&) = delete;
   SGCEngine& operator=(const SGCEngine&) = delete;
@@ -53,4 +254,6 @@ class SGCEngine {
   void scrollCallback(double offsetX, double offsetY);
 
   void keyCallback(int key, int scancode, int action, int mods);
+
+  void requestRedraw();
 };
\ No newline at end of file
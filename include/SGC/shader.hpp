@@ -0,0 +1,8 @@
+#pragma once
+
+#include <SGC/opengl.hpp>
+
+// Compiles and links a program, returns 0 on failure.
+GLuint makeProgram(const GLchar* vertexSource, const GLchar* fragmentSource);
+
+GLuint makeComputeProgram(const GLchar* computeSource);
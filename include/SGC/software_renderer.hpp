@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SGC/graph.hpp>
+#include <SGC/jit.hpp>
+#include <SGC/thread_pool.hpp>
+#include <SGC/view.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// CPU version of the fragment shader. The frame is split into tiles that are
+// shaded in parallel, the result is RGBA8 with the bottom row first.
+class SoftwareRenderer {
+ public:
+  static constexpr int tileSize = 64;
+
+  void setGraphs(const std::vector<Graph>& sourceGraphs);
+
+  // Why a visible graph of the last setGraphs is not drawn, by graph name.
+  const std::unordered_map<std::string, std::string>& getSkippedGraphs() const;
+
+  void render(const View& view);
+
+  const std::vector<std::uint32_t>& getPixels() const;
+
+  std::size_t getThreadCount() const;
+
+ private:
+  struct CompiledGraph {
+    std::shared_ptr<const CompiledExpression> expression;
+    bool isFunctional;
+    bool isColumnConstant;
+    float thickness;
+    std::uint32_t color;
+  };
+
+  std::vector<CompiledGraph> graphs;
+  std::unordered_map<std::string, std::string> skippedGraphs;
+  std::vector<std::uint32_t> pixels;
+  ThreadPool threadPool;
+
+  void renderTile(const View& view, int tileX, int tileY);
+};
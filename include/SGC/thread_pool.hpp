@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork-join pool. Every participant owns a contiguous range of indices and
+// steals from the other ranges once its own is exhausted.
+class ThreadPool {
+ public:
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+
+  ~ThreadPool();
+
+  std::size_t getThreadCount() const;
+
+  // Runs task(index) for every index in [0, count), the calling thread
+  // participates. Returns when all indices are done.
+  void parallelFor(std::size_t count,
+                   const std::function<void(std::size_t)>& task);
+
+ private:
+  struct alignas(64) Range {
+    std::atomic<std::size_t> next = 0;
+    std::size_t end = 0;
+  };
+
+  std::vector<std::thread> workers;
+  std::unique_ptr<Range[]> ranges;
+
+  std::mutex mutex;
+  std::condition_variable startCondition;
+  std::condition_variable doneCondition;
+  std::size_t generation = 0;
+  std::size_t activeWorkers = 0;
+  bool isStopping = false;
+  const std::function<void(std::size_t)>* currentTask = nullptr;
+
+  void workerLoop(std::size_t participant);
+
+  void runTasks(std::size_t participant);
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <SGC/render_target.hpp>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+// Fixed-size tile textures of static graphs keyed by content, zoom level and
+// tile position. Least recently used tiles are evicted over the budget.
+class TileCache {
+ public:
+  static constexpr int tileSize = 256;
+
+  struct Key {
+    std::size_t contentHash;
+    int level;
+    int x;
+    int y;
+
+    bool operator==(const Key& other) const = default;
+  };
+
+  std::size_t budgetMegabytes = 256;
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+
+  // Returns the tile texture or 0, a found tile becomes most recently used.
+  GLuint find(const Key& key);
+
+  // Allocates a tile to render into, evicting tiles over the budget.
+  RenderTarget& insert(const Key& key);
+
+  void clear();
+
+  std::size_t getTileCount() const;
+
+  std::size_t getMemoryUsage() const;
+
+ private:
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    std::unique_ptr<RenderTarget> target;
+    std::list<Key>::iterator usage;
+  };
+
+  std::list<Key> usageOrder;
+  std::unordered_map<Key, Entry, KeyHash> tiles;
+};
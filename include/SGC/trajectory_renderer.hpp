@@ -0,0 +1,92 @@
+#pragma once
+
+#include <SGC/graph.hpp>
+#include <SGC/opengl.hpp>
+#include <SGC/view.hpp>
+#include <cstdint>
+#include <vector>
+
+// Solution curves of ODE graphs. A compute shader integrates both directions
+// from every seed in parallel into a point buffer. Buffers are kept for the
+// recently drawn values of the t and a the body reads, so sweep cells and
+// split views integrate once rather than every frame, until the system, the
+// seeds or the method change. The curves are drawn from the buffer as
+// anti-aliased segment quads.
+class TrajectoryRenderer {
+ public:
+  static constexpr int maxSeeds = 4096;
+  // Per direction, the seed included. Points after the curve ends are NaN.
+  static constexpr int pointsPerTrajectory = 512;
+  // Fixed RK4 step and largest RK45 step, in the curve parameter.
+  static constexpr float stepSize = 1.0f / 32.0f;
+  static constexpr float maxAdaptiveStep = 0.25f;
+  // Point buffers kept per system, at least one is always kept.
+  static constexpr GLsizeiptr maxCachedPointBytes = 64 << 20;
+
+  TrajectoryRenderer() = default;
+  TrajectoryRenderer(const TrajectoryRenderer&) = delete;
+  TrajectoryRenderer& operator=(const TrajectoryRenderer&) = delete;
+  TrajectoryRenderer(TrajectoryRenderer&&) = delete;
+  TrajectoryRenderer& operator=(TrajectoryRenderer&&) = delete;
+
+  ~TrajectoryRenderer();
+
+  // Compiles an integrator for every visible ODE graph. Returns false and
+  // keeps the previous graphs if one fails.
+  bool setGraphs(const std::vector<Graph>& graphs);
+
+  // Takes the seeds, methods, colors and thicknesses of the graphs set last,
+  // without compiling. Only new seeds or methods integrate again.
+  void setStyles(const std::vector<Graph>& graphs);
+
+  // Integrates where needed and blends the curves over the bound framebuffer,
+  // earlier graphs on top, with the camera of the bound Camera block.
+  void draw(const View& view);
+
+  void release();
+
+ private:
+  struct Integration {
+    // The t and a the points were integrated for, 0 if the body ignores them.
+    float time = 0.0f;
+    float parameter = 0.0f;
+    GLuint pointBuffer = 0;
+    // The least recently used buffer is integrated again first.
+    std::uint64_t lastUse = 0;
+  };
+
+  struct System {
+    GLuint program = 0;
+    GLint timeUniformLocation = -1;
+    GLint parameterUniformLocation = -1;
+    GLint seedCountUniformLocation = -1;
+    GLint methodUniformLocation = -1;
+    bool usesTime = false;
+    bool usesParameter = false;
+    std::vector<GLfloat> seeds;
+    OdeMethod method = OdeMethod::RK4;
+    GLfloat color[3] = {};
+    GLfloat halfWidth = 0.5f;
+    GLuint seedBuffer = 0;
+    std::vector<Integration> integrations;
+  };
+
+  std::vector<System> systems;
+  std::uint64_t useCount = 0;
+  GLuint lineProgram = 0;
+  GLint halfWidthUniformLocation = -1;
+  GLint colorUniformLocation = -1;
+  GLuint vertexArray = 0;
+
+  void create();
+
+  // Point buffer of the system for the t and a of the view, integrated if no
+  // kept buffer matches.
+  GLuint getPointBuffer(System& system, const View& view);
+
+  void integrate(const System& system, const Integration& integration);
+
+  static void releaseIntegrations(System& system);
+
+  void releaseSystems();
+};
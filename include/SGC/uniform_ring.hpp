@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SGC/opengl.hpp>
+
+// Uniform buffer for data that changes every draw, split in one region per
+// frame in flight. With GL_ARB_buffer_storage the buffer stays mapped and a
+// push is a memcpy, a fence per region keeps the CPU from writing data the
+// GPU still reads. Without it pushes fall back to glBufferSubData.
+class UniformRing {
+ public:
+  static constexpr int regionCount = 3;
+  static constexpr GLsizeiptr regionSize = 1024 * 1024;
+
+  UniformRing() = default;
+  UniformRing(const UniformRing&) = delete;
+  UniformRing& operator=(const UniformRing&) = delete;
+  UniformRing(UniformRing&&) = delete;
+  UniformRing& operator=(UniformRing&&) = delete;
+
+  ~UniformRing();
+
+  // Moves to the next region, waiting for the frame that used it last.
+  void beginFrame();
+
+  void endFrame();
+
+  // Copies the data into the current region and binds it to the uniform
+  // block binding.
+  void push(GLuint binding, const void* data, GLsizeiptr size);
+
+  bool isPersistent() const;
+
+  void release();
+
+ private:
+  GLuint buffer = 0;
+  char* mapping = nullptr;
+  GLint offsetAlignment = 256;
+  GLsync fences[regionCount] = {};
+  int region = 0;
+  GLsizeiptr offset = 0;
+
+  void create();
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SGC/graph.hpp>
+#include <SGC/opengl.hpp>
+#include <SGC/view.hpp>
+#include <vector>
+
+// Vector field graphs as arrow glyphs on a world aligned lattice. Every arrow
+// is an instance of one shared quad, the vertex shader evaluates the field at
+// its lattice point and turns the quad along it, the fragment shader cuts the
+// arrow out of the quad. A field costs one draw call at any density.
+class VectorFieldRenderer {
+ public:
+  // Smallest distance between arrows, in pixels. The lattice period is the
+  // next 1, 2 or 5 times a power of ten, so it changes in steps with the zoom.
+  static constexpr float minSpacing = 36.0f;
+
+  VectorFieldRenderer() = default;
+  VectorFieldRenderer(const VectorFieldRenderer&) = delete;
+  VectorFieldRenderer& operator=(const VectorFieldRenderer&) = delete;
+  VectorFieldRenderer(VectorFieldRenderer&&) = delete;
+  VectorFieldRenderer& operator=(VectorFieldRenderer&&) = delete;
+
+  ~VectorFieldRenderer();
+
+  // Compiles a program for every visible vector field graph. Returns false
+  // and keeps the previous fields if one fails.
+  bool setGraphs(const std::vector<Graph>& graphs);
+
+  // Blends the arrows over the bound framebuffer, earlier graphs on top, with
+  // the camera of the bound Camera block.
+  void draw(const View& view);
+
+  void release();
+
+ private:
+  struct Field {
+    GLuint program = 0;
+    GLint spacingUniformLocation = -1;
+    GLint firstCellUniformLocation = -1;
+    GLint columnCountUniformLocation = -1;
+  };
+
+  std::vector<Field> fields;
+  GLuint vertexArray = 0;
+  GLuint glyphBuffer = 0;
+
+  void makeGlyph();
+
+  void releaseFields();
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+// Camera and grid state of one rendered frame, shared by all render paths.
+struct View {
+  int width = 800;
+  int height = 800;
+  float positionX = 0.0f;
+  float positionY = 0.0f;
+  float zoom = 200.0f;
+  float sublinePeriod = 1.0f;
+  float microlinePeriod = 0.1f;
+  float t = 0.0f;
+  // Value of the graph parameter a.
+  float parameter = 1.0f;
+  // Sub-pixel offset of the per pixel graph samples, in pixels.
+  float jitterX = 0.0f;
+  float jitterY = 0.0f;
+  // Bottom left pixel of the view in the framebuffer, views of a split window
+  // share one framebuffer.
+  int originX = 0;
+  int originY = 0;
+};
+
+// Grid periods are powers of ten chosen from the zoom and the larger window
+// side.
+void setGridPeriods(View& view, float windowExtent);
+
+// Same size, zoom, grid periods and parameter, position and time may differ.
+bool hasSameScale(const View& a, const View& b);
+
+bool hasSamePosition(const View& a, const View& b);
+
+bool hasSameTime(const View& a, const View& b);
+
+// Sets the jitter to the Halton (2, 3) point of the index, inside the pixel
+// around its center.
+void setJitter(View& view, int index);
+
+// Rectangle in normalized device or texture coordinates.
+struct Rect {
+  float x0;
+  float y0;
+  float x1;
+  float y1;
+};
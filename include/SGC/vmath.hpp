@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+// Branch-free float math over arrays, written so the loops vectorize. Argument
+// reduction is done in fp32 like on the GPU, so results follow what the
+// shader shows rather than libm:
+// - sin, cos: absolute error below 1e-6 for |x| < 1e4
+// - tan, cot: relative error below 1e-6 within a period, away from the poles
+// - exp: relative error below 1e-6 for -87 < x < 88
+// - log: relative error below 1e-6 for normal x, absolute below 1e-7 near 1
+// - pow: exp(b * log(|a|)), relative error below 1e-5 for |b * log(|a|)| up
+//   to 32, negative bases only for integer exponents
+// tests/vmath_test.cpp checks these against libm.
+namespace vmath {
+
+void sin(float* values, std::size_t count);
+
+void cos(float* values, std::size_t count);
+
+void tan(float* values, std::size_t count);
+
+void cot(float* values, std::size_t count);
+
+void exp(float* values, std::size_t count);
+
+void log(float* values, std::size_t count);
+
+void pow(float* bases, const float* exponents, std::size_t count);
+
+}  // namespace vmath
@@ -0,0 +1,24 @@
+#include <SGC/animation_clock.hpp>
+#include <cmath>
+
+void AnimationClock::update(double now) {
+  if (isPlaying && lastUpdate >= 0.0) time += (now - lastUpdate) * speed;
+
+  lastUpdate = now;
+}
+
+void AnimationClock::step() {
+  time += 1.0 / (stepRate > 0.0f ? stepRate : 60.0);
+}
+
+void AnimationClock::reset() { time = 0.0; }
+
+float AnimationClock::getTime() const {
+  if (stepRate <= 0.0f) return static_cast<float>(time);
+
+  return static_cast<float>(std::floor(time * stepRate) / stepRate);
+}
+
+bool AnimationClock::isStepped() const {
+  return !isPlaying || stepRate > 0.0f;
+}
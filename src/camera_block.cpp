@@ -0,0 +1,14 @@
+#include <SGC/camera_block.hpp>
+
+CameraUniforms makeCameraUniforms(const View& view) {
+  return {
+      {static_cast<GLfloat>(view.width), static_cast<GLfloat>(view.height)},
+      {view.positionX, view.positionY},
+      {view.jitterX, view.jitterY},
+      {view.originX, view.originY},
+      view.zoom,
+      view.t,
+      view.parameter,
+      0.0f,
+  };
+}
@@ -0,0 +1,219 @@
+#include <SGC/camera_block.hpp>
+#include <SGC/column_renderer.hpp>
+#include <SGC/error.hpp>
+#include <SGC/shader.hpp>
+#include <algorithm>
+#include <string>
+
+namespace {
+
+const std::string columnComputeShaderSourceStart =            //
+    "#version 430 core\n"                                     //
+    "#define pi 3.1415927410125732\n"                         //
+    "layout (local_size_x = 64) in;"                          //
+    "layout (std430, binding = 0) writeonly buffer Ranges {"  //
+    "  vec4 ranges[];"                                        //
+    "};" +                                                    //
+    std::string(cameraBlockSource) +                          //
+    "uniform int subSamples;"                                 //
+    "uniform int graphIndex;"                                 //
+    "bool isEqualApprox(float a, float b, float c) {"         //
+    "  return abs(a - b) <= c * 0.5;"                         //
+    "}"                                                       //
+    "float f(float x) {"                                      //
+    "  float ps = 1.0 / zoom;"                                //
+    "  return ";
+
+// Column n covers screen x from n to n + 1. A sub-interval whose ends jump
+// over the window with the middle outside them is an asymptote, it is skipped
+// and the samples after it go to the second range of the column.
+const std::string columnComputeShaderSourceEnd =                            //
+    ";"                                                                     //
+    "}"                                                                     //
+    "float toScreenY(float screenX) {"                                      //
+    "  float x = (screenX - windowSize.x * 0.5) / zoom + position.x;"       //
+    "  return (f(x) - position.y) * zoom + windowSize.y * 0.5;"             //
+    "}"                                                                     //
+    "void main() {"                                                         //
+    "  int column = int(gl_GlobalInvocationID.x);"                          //
+    "  if (column >= int(windowSize.x)) return;"                            //
+    "  vec4 range = vec4(1e30, -1e30, 1e30, -1e30);"                        //
+    "  bool isBroken = false;"                                              //
+    "  float previous = toScreenY(float(column));"                          //
+    "  for (int i = 1; i <= subSamples; i++) {"                             //
+    "    float x0 = float(column) + float(i - 1) / float(subSamples);"      //
+    "    float x1 = float(column) + float(i) / float(subSamples);"          //
+    "    float current = toScreenY(x1);"                                    //
+    "    float middle = toScreenY((x0 + x1) * 0.5);"                        //
+    "    vec3 values = vec3(previous, current, middle);"                    //
+    "    bool isJump = abs(current - previous) > windowSize.y &&"           //
+    "      (middle < min(previous, current) ||"                             //
+    "      middle > max(previous, current));"                               //
+    "    previous = current;"                                               //
+    "    if (any(isnan(values)) || any(isinf(values)) || isJump) {"         //
+    "      isBroken = true;"                                                //
+    "      continue;"                                                       //
+    "    }"                                                                 //
+    "    vec2 piece = vec2(min(values.x, min(values.y, values.z)),"         //
+    "      max(values.x, max(values.y, values.z)));"                        //
+    "    if (isBroken)"                                                     //
+    "      range.zw = vec2(min(range.z, piece.x), max(range.w, piece.y));"  //
+    "    else"                                                              //
+    "      range.xy = vec2(min(range.x, piece.x), max(range.y, piece.y));"  //
+    "  }"                                                                   //
+    "  ranges[graphIndex * int(windowSize.x) + column] ="                   //
+    "    clamp(range, -windowSize.y, windowSize.y * 2.0);"                  //
+    "}";
+
+const GLchar* compositeVertexShaderSource =                     //
+    "#version 430 core\n"                                       //
+    "void main() {"                                             //
+    "  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);"  //
+    "  gl_Position = vec4(corner * 4.0 - 1.0, 0.0, 1.0);"       //
+    "}";
+
+// A style is the color and the half thickness in pixels, there is one per
+// graph.
+const std::string compositeFragmentShaderSource =                //
+    "#version 430 core\n"                                        //
+    "out vec4 FragColor;"                                        //
+    "layout (std430, binding = 0) readonly buffer Ranges {"      //
+    "  vec4 ranges[];"                                           //
+    "};"                                                         //
+    "layout (std430, binding = 1) readonly buffer Styles {"      //
+    "  vec4 styles[];"                                           //
+    "};" +                                                       //
+    std::string(cameraBlockSource) +                             //
+    "void main() {"                                              //
+    "  vec2 fragPos = gl_FragCoord.xy - vec2(origin);"           //
+    "  int column = int(fragPos.x);"                             //
+    "  int width = int(windowSize.x);"                           //
+    "  for (int i = 0; i < styles.length(); i++) {"              //
+    "    vec4 range = ranges[i * width + column];"               //
+    "    vec4 style = styles[i];"                                //
+    "    range += vec4(-style.w, style.w, -style.w, style.w);"   //
+    "    if ((fragPos.y >= range.x && fragPos.y <= range.y) ||"  //
+    "      (fragPos.y >= range.z && fragPos.y <= range.w)) {"    //
+    "      FragColor = vec4(style.rgb, 1.0);"                    //
+    "      return;"                                              //
+    "    }"                                                      //
+    "  }"                                                        //
+    "  discard;"                                                 //
+    "}";
+
+}  // namespace
+
+ColumnRenderer::~ColumnRenderer() { release(); }
+
+bool ColumnRenderer::setGraphs(const std::vector<Graph>& graphs) {
+  std::vector<Column> newColumns;
+  std::vector<GLfloat> newStyles;
+
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible || !graph.isColumnConstant()) continue;
+
+    const std::string computeSource = columnComputeShaderSourceStart +
+                                      graph.body +
+                                      columnComputeShaderSourceEnd;
+    const GLuint program = makeComputeProgram(computeSource.c_str());
+
+    if (program == 0) {
+      for (const auto& column : newColumns) glDeleteProgram(column.program);
+      return false;
+    }
+
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "subSamples"), subSamples);
+    glUniform1i(glGetUniformLocation(program, "graphIndex"),
+                static_cast<GLint>(newColumns.size()));
+    glUseProgram(0);
+
+    Column column;
+    column.program = program;
+
+    newColumns.push_back(column);
+    newStyles.insert(newStyles.end(), {graph.r, graph.g, graph.b,
+                                       graph.thickness * 0.5f});
+  }
+
+  releaseColumns();
+  columns = std::move(newColumns);
+  styles = std::move(newStyles);
+
+  if (columns.empty()) return true;
+
+  if (stylesBuffer == 0) glGenBuffers(1, &stylesBuffer);
+
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, stylesBuffer);
+  glBufferData(GL_SHADER_STORAGE_BUFFER,
+               static_cast<GLsizeiptr>(styles.size() * sizeof(GLfloat)),
+               styles.data(), GL_STATIC_DRAW);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  return true;
+}
+
+void ColumnRenderer::draw(const View& view) {
+  if (columns.empty()) return;
+
+  if (compositeProgram == 0) {
+    compositeProgram = makeProgram(compositeVertexShaderSource,
+                                   compositeFragmentShaderSource.c_str());
+
+    if (compositeProgram == 0)
+      throw SGCError(SGCErrorType::OPENGL_ERROR,
+                     "[OpenGL]: Failed to compile column composite program.\n");
+
+    glGenVertexArrays(1, &vertexArray);
+    glGenBuffers(1, &rangesBuffer);
+  }
+
+  const GLsizeiptr rangesSize = static_cast<GLsizeiptr>(
+      columns.size() * static_cast<std::size_t>(view.width) * 4 *
+      sizeof(GLfloat));
+
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, rangesBuffer);
+
+  if (rangesSize > rangesBufferSize) {
+    glBufferData(GL_SHADER_STORAGE_BUFFER, rangesSize, nullptr,
+                 GL_DYNAMIC_COPY);
+    rangesBufferSize = rangesSize;
+  }
+
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, rangesBuffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, stylesBuffer);
+
+  for (const auto& column : columns) {
+    glUseProgram(column.program);
+    glDispatchCompute(static_cast<GLuint>((view.width + 63) / 64), 1, 1);
+  }
+
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  glBindVertexArray(vertexArray);
+  glUseProgram(compositeProgram);
+  glDrawArrays(GL_TRIANGLES, 0, 3);
+
+  glBindVertexArray(0);
+  glUseProgram(0);
+}
+
+void ColumnRenderer::release() {
+  releaseColumns();
+  if (compositeProgram != 0) glDeleteProgram(compositeProgram);
+  if (vertexArray != 0) glDeleteVertexArrays(1, &vertexArray);
+  if (rangesBuffer != 0) glDeleteBuffers(1, &rangesBuffer);
+  if (stylesBuffer != 0) glDeleteBuffers(1, &stylesBuffer);
+  compositeProgram = 0;
+  vertexArray = 0;
+  rangesBuffer = 0;
+  rangesBufferSize = 0;
+  stylesBuffer = 0;
+}
+
+void ColumnRenderer::releaseColumns() {
+  for (const auto& column : columns) glDeleteProgram(column.program);
+  columns.clear();
+}
@@ -0,0 +1,149 @@
+#include <SGC/camera_block.hpp>
+#include <SGC/contour_renderer.hpp>
+#include <SGC/shader.hpp>
+#include <algorithm>
+#include <string>
+
+namespace {
+
+const GLchar* contourVertexShaderSource =                       //
+    "#version 430 core\n"                                       //
+    "void main() {"                                             //
+    "  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);"  //
+    "  gl_Position = vec4(corner * 4.0 - 1.0, 0.0, 1.0);"       //
+    "}";
+
+const std::string contourFragmentShaderSourceStart =   //
+    "#version 430 core\n"                              //
+    "#define pi 3.1415927410125732\n"                  //
+    "out vec4 FragColor;" +                            //
+    std::string(cameraBlockSource) +                   //
+    "uniform float levels[" +                          //
+    std::to_string(ContourRenderer::maxLevels) +       //
+    "];"                                               //
+    "uniform int levelCount;"                          //
+    "uniform vec3 color;"                              //
+    "uniform float halfWidth;"                         //
+    "bool isEqualApprox(float a, float b, float c) {"  //
+    "  return abs(a - b) <= c * 0.5;"                  //
+    "}"                                                //
+    "float evaluate(vec2 worldPos) {"                  //
+    "  float x = worldPos.x;"                          //
+    "  float y = worldPos.y;"                          //
+    "  float ps = 1.0 / zoom;"                         //
+    "  return float(";
+
+// The distance to a level in pixels is the value difference over the screen
+// gradient, the nearest level gives the coverage.
+const std::string contourFragmentShaderSourceEnd =                     //
+    ");"                                                               //
+    "}"                                                                //
+    "void main() {"                                                    //
+    "  vec2 pixel = gl_FragCoord.xy - vec2(origin) + jitter;"          //
+    "  float value = evaluate((pixel - windowSize * 0.5) / zoom"       //
+    "    + position);"                                                 //
+    "  float gradient = length(vec2(dFdx(value), dFdy(value)));"       //
+    "  if (isnan(value) || isinf(value) || isnan(gradient)) discard;"  //
+    "  float distance = 3.4e38;"                                       //
+    "  for (int i = 0; i < levelCount; i++)"                           //
+    "    distance = min(distance, abs(value - levels[i]));"            //
+    "  float coverage ="                                               //
+    "    clamp(halfWidth - distance / max(gradient, 1e-20) + 0.5,"     //
+    "      0.0, 1.0);"                                                 //
+    "  if (coverage <= 0.0) discard;"                                  //
+    "  FragColor = vec4(color, coverage);"                             //
+    "}";
+
+}  // namespace
+
+ContourRenderer::~ContourRenderer() { release(); }
+
+bool ContourRenderer::setGraphs(const std::vector<Graph>& graphs) {
+  std::vector<Contour> newContours;
+
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible || graph.type != GraphType::CONTOUR) continue;
+
+    const std::string fragmentSource = contourFragmentShaderSourceStart +
+                                       graph.body +
+                                       contourFragmentShaderSourceEnd;
+    const GLuint program =
+        makeProgram(contourVertexShaderSource, fragmentSource.c_str());
+
+    if (program == 0) {
+      for (const auto& contour : newContours) glDeleteProgram(contour.program);
+      return false;
+    }
+
+    Contour contour;
+    contour.program = program;
+    newContours.push_back(contour);
+  }
+
+  releaseContours();
+  contours = std::move(newContours);
+  setStyles(graphs);
+
+  return true;
+}
+
+void ContourRenderer::setStyles(const std::vector<Graph>& graphs) {
+  std::size_t i = 0;
+
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible || graph.type != GraphType::CONTOUR) continue;
+    if (i == contours.size()) break;
+
+    // Styles live in the program, draw only binds it.
+    Contour& contour = contours[i++];
+    contour.levelCount = static_cast<GLsizei>(
+        std::min(graph.levels.size(), static_cast<std::size_t>(maxLevels)));
+
+    glUseProgram(contour.program);
+    glUniform1fv(glGetUniformLocation(contour.program, "levels"),
+                 contour.levelCount, graph.levels.data());
+    glUniform1i(glGetUniformLocation(contour.program, "levelCount"),
+                contour.levelCount);
+    glUniform3f(glGetUniformLocation(contour.program, "color"), graph.r,
+                graph.g, graph.b);
+    glUniform1f(glGetUniformLocation(contour.program, "halfWidth"),
+                graph.thickness * 0.5f);
+  }
+
+  glUseProgram(0);
+}
+
+void ContourRenderer::draw() {
+  if (contours.empty()) return;
+
+  if (vertexArray == 0) glGenVertexArrays(1, &vertexArray);
+
+  glEnable(GL_BLEND);
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                      GL_ONE_MINUS_SRC_ALPHA);
+
+  glBindVertexArray(vertexArray);
+
+  for (auto contour = contours.rbegin(); contour != contours.rend();
+       contour++) {
+    if (contour->levelCount == 0) continue;
+
+    glUseProgram(contour->program);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+  }
+
+  glBindVertexArray(0);
+  glUseProgram(0);
+  glDisable(GL_BLEND);
+}
+
+void ContourRenderer::release() {
+  releaseContours();
+  if (vertexArray != 0) glDeleteVertexArrays(1, &vertexArray);
+  vertexArray = 0;
+}
+
+void ContourRenderer::releaseContours() {
+  for (const auto& contour : contours) glDeleteProgram(contour.program);
+  contours.clear();
+}
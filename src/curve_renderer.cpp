@@ -0,0 +1,154 @@
+#include <SGC/camera_block.hpp>
+#include <SGC/curve_renderer.hpp>
+#include <SGC/shader.hpp>
+#include <algorithm>
+
+namespace {
+
+const std::string curveVertexShaderSourceStart =        //
+    "#version 430 core\n"                               //
+    "#define pi 3.1415927410125732\n" +                 //
+    std::string(cameraBlockSource) +                    //
+    "uniform int samplesPerPixel;"                      //
+    "uniform float halfWidth;"                          //
+    "noperspective out float lineDistance;"             //
+    "const int corners[6] = int[6](0, 1, 2, 2, 1, 3);"  //
+    "bool isEqualApprox(float a, float b, float c) {"   //
+    "  return abs(a - b) <= c * 0.5;"                   //
+    "}"                                                 //
+    "float f(float x) {"                                //
+    "  float ps = 1.0 / zoom;"                          //
+    "  return ";
+
+// Screen coordinates are in pixels with pixel centers at n + 0.5, the same
+// mapping the graph fragment shader uses.
+const std::string curveVertexShaderSourceEnd =                         //
+    ";"                                                                //
+    "}"                                                                //
+    "vec2 toScreen(float screenX) {"                                   //
+    "  float x = (screenX - windowSize.x * 0.5) / zoom + position.x;"  //
+    "  return vec2(screenX,"                                           //
+    "    (f(x) - position.y) * zoom + windowSize.y * 0.5);"            //
+    "}"                                                                //
+    "void main() {"                                                    //
+    "  int segment = gl_VertexID / 6;"                                 //
+    "  int corner = corners[gl_VertexID % 6];"                         //
+    "  float x0 = float(segment) / float(samplesPerPixel) - 1.0;"      //
+    "  float x1 = float(segment + 1) / float(samplesPerPixel) - 1.0;"  //
+    "  vec2 p0 = toScreen(x0);"                                        //
+    "  vec2 p1 = toScreen(x1);"                                        //
+    "  float middle = toScreen((x0 + x1) * 0.5).y;"                    //
+    "  vec3 values = vec3(p0.y, p1.y, middle);"                        //
+    "  bool isJump = abs(p1.y - p0.y) > windowSize.y &&"               //
+    "    (middle < min(p0.y, p1.y) || middle > max(p0.y, p1.y));"      //
+    "  if (any(isnan(values)) || any(isinf(values)) || isJump) {"      //
+    "    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);"                      //
+    "    lineDistance = 0.0;"                                          //
+    "    return;"                                                      //
+    "  }"                                                              //
+    "  p0.y = clamp(p0.y, -windowSize.y, windowSize.y * 2.0);"         //
+    "  p1.y = clamp(p1.y, -windowSize.y, windowSize.y * 2.0);"         //
+    "  vec2 direction = p1 - p0;"                                      //
+    "  direction = length(direction) > 1e-6"                           //
+    "    ? normalize(direction) : vec2(1.0, 0.0);"                     //
+    "  vec2 normal = vec2(-direction.y, direction.x);"                 //
+    "  float extent = halfWidth + 1.0;"                                //
+    "  float side = (corner & 2) != 0 ? 1.0 : -1.0;"                   //
+    "  vec2 point = (corner & 1) != 0 ? p1 + direction * extent"       //
+    "    : p0 - direction * extent;"                                   //
+    "  point += normal * side * extent;"                               //
+    "  lineDistance = side * extent;"                                  //
+    "  gl_Position = vec4(point / windowSize * 2.0 - 1.0, 0.0, 1.0);"  //
+    "}";
+
+const GLchar* curveFragmentShaderSource =                        //
+    "#version 430 core\n"                                        //
+    "noperspective in float lineDistance;"                       //
+    "out vec4 FragColor;"                                        //
+    "uniform float halfWidth;"                                   //
+    "uniform vec3 color;"                                        //
+    "void main() {"                                              //
+    "  float coverage ="                                         //
+    "    clamp(halfWidth + 0.5 - abs(lineDistance), 0.0, 1.0);"  //
+    "  if (coverage <= 0.0) discard;"                            //
+    "  FragColor = vec4(color, coverage);"                       //
+    "}";
+
+}  // namespace
+
+CurveRenderer::~CurveRenderer() { release(); }
+
+bool CurveRenderer::setGraphs(const std::vector<Graph>& graphs) {
+  std::vector<Curve> newCurves;
+
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible || !graph.isColumnConstant()) continue;
+
+    const std::string vertexSource = curveVertexShaderSourceStart +
+                                     graph.body + curveVertexShaderSourceEnd;
+    const GLuint program =
+        makeProgram(vertexSource.c_str(), curveFragmentShaderSource);
+
+    if (program == 0) {
+      for (const auto& curve : newCurves) glDeleteProgram(curve.program);
+      return false;
+    }
+
+    // Styles are part of the program, the camera comes from the Camera block.
+    // The fragment shader test is |f(x) - y| <= thickness / 2 pixels.
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "samplesPerPixel"),
+                samplesPerPixel);
+    glUniform1f(glGetUniformLocation(program, "halfWidth"),
+                std::max(graph.thickness * 0.5f, 0.5f));
+    glUniform3f(glGetUniformLocation(program, "color"), graph.r, graph.g,
+                graph.b);
+    glUseProgram(0);
+
+    Curve curve;
+    curve.program = program;
+
+    newCurves.push_back(curve);
+  }
+
+  releaseCurves();
+  curves = std::move(newCurves);
+
+  return true;
+}
+
+void CurveRenderer::draw(const View& view) {
+  if (curves.empty()) return;
+
+  // Attribute-less draw, vertices are generated from gl_VertexID.
+  if (vertexArray == 0) glGenVertexArrays(1, &vertexArray);
+
+  const GLsizei segmentCount = (view.width + 2) * samplesPerPixel;
+
+  glBindVertexArray(vertexArray);
+  glDisable(GL_CULL_FACE);
+  glEnable(GL_BLEND);
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                      GL_ONE_MINUS_SRC_ALPHA);
+
+  for (auto curve = curves.rbegin(); curve != curves.rend(); curve++) {
+    glUseProgram(curve->program);
+    glDrawArrays(GL_TRIANGLES, 0, segmentCount * 6);
+  }
+
+  glDisable(GL_BLEND);
+  glEnable(GL_CULL_FACE);
+  glBindVertexArray(0);
+  glUseProgram(0);
+}
+
+void CurveRenderer::release() {
+  releaseCurves();
+  if (vertexArray != 0) glDeleteVertexArrays(1, &vertexArray);
+  vertexArray = 0;
+}
+
+void CurveRenderer::releaseCurves() {
+  for (const auto& curve : curves) glDeleteProgram(curve.program);
+  curves.clear();
+}
@@ -0,0 +1,272 @@
+#include <SGC/camera_block.hpp>
+#include <SGC/edge_supersampler.hpp>
+#include <SGC/error.hpp>
+#include <SGC/shader.hpp>
+#include <algorithm>
+#include <string>
+
+namespace {
+
+// shade returns the premultiplied color of the first graph covering a screen
+// position. The low bits of sides hold the signs of the graph boundary values,
+// folded into 31 bits by xor, so a sign change between samples marks curves
+// and bands thinner than a pixel. The top bit is set near an isEqualApprox
+// band.
+const std::string shadeSourceStart =                                  //
+    "#version 430 core\n"                                             //
+    "#define pi 3.1415927410125732\n"                                 //
+    "layout (std430, binding = 0) buffer Edges {"                     //
+    "  uint groupsX;"                                                 //
+    "  uint groupsY;"                                                 //
+    "  uint groupsZ;"                                                 //
+    "  uint count;"                                                   //
+    "  uint pixels[];"                                                //
+    "};"                                                              //
+    "layout (rgba8, binding = 0) writeonly uniform image2D layer;" +  //
+    std::string(cameraBlockSource) +                                  //
+    "bool isEqualApprox(float a, float b, float c) {"                 //
+    "  return abs(a - b) <= c * 0.5;"                                 //
+    "}"                                                               //
+    "vec4 shade(vec2 screenPos, out uint sides) {"                    //
+    "  float pixelSize = 1.0 / zoom;"                                 //
+    "  vec2 worldPos = (screenPos - windowSize * 0.5) * pixelSize"    //
+    "    + position;"                                                 //
+    "  float x = worldPos.x;"                                         //
+    "  float y = worldPos.y;"                                         //
+    "  float ps = pixelSize;"                                         //
+    "  vec4 FragColor = vec4(0.0);"                                   //
+    "  sides = 0u;";
+
+const std::string shadeSourceMiddle =  //
+    "  FragColor = vec4(0.0);";
+
+// The tile of shared samples has a one pixel border for the neighbourhood.
+const std::string markSourceEnd =                                           //
+    "  return FragColor;"                                                   //
+    "}"                                                                     //
+    "layout (local_size_x = 16, local_size_y = 16) in;"                     //
+    "shared vec4 tileColors[18 * 18];"                                      //
+    "shared uint tileSides[18 * 18];"                                       //
+    "void main() {"                                                         //
+    "  ivec2 tileOrigin = ivec2(gl_WorkGroupID.xy) * 16 - 1;"               //
+    "  for (uint i = gl_LocalInvocationIndex; i < 18u * 18u; i += 256u) {"  //
+    "    uint cellSides;"                                                   //
+    "    ivec2 cell = tileOrigin + ivec2(i % 18u, i / 18u);"                //
+    "    tileColors[i] = shade(vec2(cell) + 0.5, cellSides);"               //
+    "    tileSides[i] = cellSides;"                                         //
+    "  }"                                                                   //
+    "  barrier();"                                                          //
+    "  ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);"                      //
+    "  if (any(greaterThanEqual(pixel, ivec2(windowSize)))) return;"        //
+    "  int center = (int(gl_LocalInvocationID.y) + 1) * 18"                 //
+    "    + int(gl_LocalInvocationID.x) + 1;"                                //
+    "  imageStore(layer, pixel, tileColors[center]);"                       //
+    "  bool isEdge = (tileSides[center] & 0x80000000u) != 0u;"              //
+    "  for (int dy = -18; dy <= 18; dy += 18)"                              //
+    "    for (int dx = -1; dx <= 1; dx++)"                                  //
+    "      isEdge = isEdge ||"                                              //
+    "        tileColors[center + dy + dx] != tileColors[center] ||"         //
+    "        tileSides[center + dy + dx] != tileSides[center];"             //
+    "  if (!isEdge) return;"                                                //
+    "  uint index = atomicAdd(count, 1u);"                                  //
+    "  pixels[index] = uint(pixel.y) << 16 | uint(pixel.x);"                //
+    "  atomicMax(groupsX, index / 64u + 1u);"                               //
+    "}";
+
+const std::string supersampleSourceEnd =                                //
+    "  return FragColor;"                                               //
+    "}"                                                                 //
+    "layout (local_size_x = 64) in;"                                    //
+    "uniform int samplesPerAxis;"                                       //
+    "void main() {"                                                     //
+    "  uint index = gl_GlobalInvocationID.x;"                           //
+    "  if (index >= count) return;"                                     //
+    "  uint packedPixel = pixels[index];"                               //
+    "  ivec2 pixel = ivec2(packedPixel & 0xffffu, packedPixel >> 16);"  //
+    "  vec4 sum = vec4(0.0);"                                           //
+    "  uint sampleSides;"                                               //
+    "  for (int i = 0; i < samplesPerAxis; i++)"                        //
+    "    for (int j = 0; j < samplesPerAxis; j++)"                      //
+    "      sum += shade(vec2(pixel) + (vec2(j, i) + 0.5)"               //
+    "        / float(samplesPerAxis), sampleSides);"                    //
+    "  imageStore(layer, pixel,"                                        //
+    "    sum / float(samplesPerAxis * samplesPerAxis));"                //
+    "}";
+
+const GLchar* compositeVertexShaderSource =                     //
+    "#version 430 core\n"                                       //
+    "void main() {"                                             //
+    "  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);"  //
+    "  gl_Position = vec4(corner * 4.0 - 1.0, 0.0, 1.0);"       //
+    "}";
+
+const GLchar* compositeFragmentShaderSource =                      //
+    "#version 430 core\n"                                          //
+    "out vec4 FragColor;"                                          //
+    "uniform sampler2D layer;"                                     //
+    "void main() {"                                                //
+    "  FragColor = texelFetch(layer, ivec2(gl_FragCoord.xy), 0);"  //
+    "  if (FragColor.a <= 0.0) discard;"                           //
+    "}";
+
+}  // namespace
+
+EdgeSupersampler::~EdgeSupersampler() { release(); }
+
+bool EdgeSupersampler::setGraphs(const std::vector<Graph>& graphs) {
+  std::string graphParts;
+  std::string sideParts;
+  int boundaryCount = 0;
+
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible) continue;
+
+    graphParts += graph.getGraphShaderPart();
+
+    const std::string value = graph.getBoundaryValue();
+    if (value.empty()) continue;
+
+    const std::string bandWidth = graph.getBandWidth();
+
+    sideParts += "{ float value = " + value + ";";
+    sideParts += " if (value > 0.0) sides ^= 1u << " +
+                 std::to_string(boundaryCount++ % 31) + ";";
+    if (!bandWidth.empty())
+      sideParts += " if (abs(value) <= " + bandWidth +
+                   ") sides |= 0x80000000u;";
+    sideParts += " }";
+  }
+
+  if (graphParts.empty()) {
+    releasePrograms();
+    return true;
+  }
+
+  const std::string shadeSource =
+      shadeSourceStart + sideParts + graphParts + shadeSourceMiddle;
+  const std::string markSource = shadeSource + markSourceEnd;
+  const std::string supersampleSource = shadeSource + supersampleSourceEnd;
+
+  const GLuint newMarkProgram = makeComputeProgram(markSource.c_str());
+  const GLuint newSupersampleProgram =
+      newMarkProgram != 0 ? makeComputeProgram(supersampleSource.c_str()) : 0;
+
+  if (newSupersampleProgram == 0) {
+    if (newMarkProgram != 0) glDeleteProgram(newMarkProgram);
+    return false;
+  }
+
+  releasePrograms();
+  markProgram = newMarkProgram;
+  supersampleProgram = newSupersampleProgram;
+
+  glUseProgram(supersampleProgram);
+  glUniform1i(glGetUniformLocation(supersampleProgram, "samplesPerAxis"),
+              samplesPerAxis);
+  glUseProgram(0);
+
+  return true;
+}
+
+void EdgeSupersampler::draw(const View& view) {
+  if (markProgram == 0) return;
+
+  if (compositeProgram == 0) {
+    compositeProgram = makeProgram(compositeVertexShaderSource,
+                                   compositeFragmentShaderSource);
+
+    if (compositeProgram == 0)
+      throw SGCError(
+          SGCErrorType::OPENGL_ERROR,
+          "[OpenGL]: Failed to compile edge supersampling program.\n");
+
+    glGenVertexArrays(1, &vertexArray);
+    glGenBuffers(1, &edgesBuffer);
+  }
+
+  if (layerWidth != view.width || layerHeight != view.height) {
+    if (layerTexture != 0) glDeleteTextures(1, &layerTexture);
+
+    glGenTextures(1, &layerTexture);
+    glBindTexture(GL_TEXTURE_2D, layerTexture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, view.width, view.height);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    layerWidth = view.width;
+    layerHeight = view.height;
+  }
+
+  // Header of the indirect dispatch and the list length, then the list.
+  const GLuint header[4] = {0, 1, 1, 0};
+  const GLsizeiptr edgesSize = static_cast<GLsizeiptr>(
+      sizeof(header) + static_cast<std::size_t>(view.width) *
+                           static_cast<std::size_t>(view.height) *
+                           sizeof(GLuint));
+
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, edgesBuffer);
+
+  if (edgesSize > edgesBufferSize) {
+    glBufferData(GL_SHADER_STORAGE_BUFFER, edgesSize, nullptr,
+                 GL_DYNAMIC_COPY);
+    edgesBufferSize = edgesSize;
+  }
+
+  glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(header), header);
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, edgesBuffer);
+  glBindImageTexture(0, layerTexture, 0, GL_FALSE, 0, GL_WRITE_ONLY,
+                     GL_RGBA8);
+
+  glUseProgram(markProgram);
+  glDispatchCompute(static_cast<GLuint>((view.width + 15) / 16),
+                    static_cast<GLuint>((view.height + 15) / 16), 1);
+
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT |
+                  GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+  glUseProgram(supersampleProgram);
+
+  glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, edgesBuffer);
+  glDispatchComputeIndirect(0);
+  glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+
+  glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+  // The layer holds premultiplied colors.
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+  glBindVertexArray(vertexArray);
+  glUseProgram(compositeProgram);
+  glBindTexture(GL_TEXTURE_2D, layerTexture);
+
+  glDrawArrays(GL_TRIANGLES, 0, 3);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindVertexArray(0);
+  glUseProgram(0);
+  glDisable(GL_BLEND);
+}
+
+void EdgeSupersampler::release() {
+  releasePrograms();
+  if (compositeProgram != 0) glDeleteProgram(compositeProgram);
+  if (vertexArray != 0) glDeleteVertexArrays(1, &vertexArray);
+  if (edgesBuffer != 0) glDeleteBuffers(1, &edgesBuffer);
+  compositeProgram = 0;
+  vertexArray = 0;
+  edgesBuffer = 0;
+  if (layerTexture != 0) glDeleteTextures(1, &layerTexture);
+  edgesBufferSize = 0;
+  layerTexture = 0;
+  layerWidth = 0;
+  layerHeight = 0;
+}
+
+void EdgeSupersampler::releasePrograms() {
+  if (markProgram != 0) glDeleteProgram(markProgram);
+  if (supersampleProgram != 0) glDeleteProgram(supersampleProgram);
+  markProgram = 0;
+  supersampleProgram = 0;
+}
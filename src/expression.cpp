@@ -0,0 +1,440 @@
+#include <SGC/error.hpp>
+#include <SGC/expression.hpp>
+#include <SGC/vmath.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+class Parser {
+ public:
+  std::vector<Instruction> instructions;
+
+  explicit Parser(const std::string& text) : source(text) {}
+
+  bool parse() {
+    bool isBoolean = parseOr();
+    skipSpaces();
+    if (pos != source.size()) fail("Unexpected symbol");
+    return isBoolean;
+  }
+
+ private:
+  const std::string& source;
+  std::size_t pos = 0;
+
+  [[noreturn]] void fail(const std::string& reason) const {
+    throw SGCError(SGCErrorType::EXPRESSION_ERROR,
+                   "[Expression]: " + reason + " at " + std::to_string(pos) +
+                       " in \"" + source + "\".\n");
+  }
+
+  void skipSpaces() {
+    while (pos < source.size() &&
+           std::isspace(static_cast<unsigned char>(source[pos])))
+      pos++;
+  }
+
+  bool accept(const char* token) {
+    skipSpaces();
+    std::string_view view(token);
+    if (source.compare(pos, view.size(), view) != 0) return false;
+    pos += view.size();
+    return true;
+  }
+
+  void expect(const char* token) {
+    if (!accept(token)) fail("Expected \"" + std::string(token) + "\"");
+  }
+
+  void emit(OpCode op, float value = 0.0f) {
+    instructions.push_back({op, value});
+  }
+
+  bool parseOr() {
+    bool isBoolean = parseAnd();
+    while (accept("||")) {
+      parseAnd();
+      emit(OpCode::OR);
+      isBoolean = true;
+    }
+    return isBoolean;
+  }
+
+  bool parseAnd() {
+    bool isBoolean = parseEquality();
+    while (accept("&&")) {
+      parseEquality();
+      emit(OpCode::AND);
+      isBoolean = true;
+    }
+    return isBoolean;
+  }
+
+  bool parseEquality() {
+    bool isBoolean = parseRelational();
+    while (true) {
+      if (accept("=="))
+        parseRelational(), emit(OpCode::EQUAL);
+      else if (accept("!="))
+        parseRelational(), emit(OpCode::NOT_EQUAL);
+      else
+        return isBoolean;
+      isBoolean = true;
+    }
+  }
+
+  bool parseRelational() {
+    bool isBoolean = parseAdditive();
+    while (true) {
+      if (accept("<="))
+        parseAdditive(), emit(OpCode::LESS_EQUAL);
+      else if (accept(">="))
+        parseAdditive(), emit(OpCode::GREATER_EQUAL);
+      else if (accept("<"))
+        parseAdditive(), emit(OpCode::LESS);
+      else if (accept(">"))
+        parseAdditive(), emit(OpCode::GREATER);
+      else
+        return isBoolean;
+      isBoolean = true;
+    }
+  }
+
+  bool parseAdditive() {
+    bool isBoolean = parseMultiplicative();
+    while (true) {
+      if (accept("+"))
+        parseMultiplicative(), emit(OpCode::ADD);
+      else if (accept("-"))
+        parseMultiplicative(), emit(OpCode::SUB);
+      else
+        return isBoolean;
+      isBoolean = false;
+    }
+  }
+
+  bool parseMultiplicative() {
+    bool isBoolean = parseUnary();
+    while (true) {
+      if (accept("*"))
+        parseUnary(), emit(OpCode::MUL);
+      else if (accept("/"))
+        parseUnary(), emit(OpCode::DIV);
+      else
+        return isBoolean;
+      isBoolean = false;
+    }
+  }
+
+  bool parseUnary() {
+    if (accept("-")) {
+      parseUnary();
+      emit(OpCode::NEG);
+      return false;
+    }
+    if (accept("+")) return parseUnary();
+    if (accept("!")) {
+      parseUnary();
+      emit(OpCode::NOT);
+      return true;
+    }
+    return parsePrimary();
+  }
+
+  bool parsePrimary() {
+    skipSpaces();
+
+    if (pos >= source.size()) fail("Unexpected end");
+
+    if (accept("(")) {
+      bool isBoolean = parseOr();
+      expect(")");
+      return isBoolean;
+    }
+
+    char c = source[pos];
+
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+      const char* begin = source.c_str() + pos;
+      char* end = nullptr;
+      float value = std::strtof(begin, &end);
+      if (end == begin) fail("Invalid number");
+      pos += static_cast<std::size_t>(end - begin);
+      if (pos < source.size() && (source[pos] == 'f' || source[pos] == 'F'))
+        pos++;
+      emit(OpCode::PUSH_CONST, value);
+      return false;
+    }
+
+    if (!std::isalpha(static_cast<unsigned char>(c)) && c != '_')
+      fail("Unexpected symbol");
+
+    std::size_t begin = pos;
+    while (pos < source.size() &&
+           (std::isalnum(static_cast<unsigned char>(source[pos])) ||
+            source[pos] == '_'))
+      pos++;
+    std::string name = source.substr(begin, pos - begin);
+
+    if (name == "x") return emit(OpCode::PUSH_X), false;
+    if (name == "y") return emit(OpCode::PUSH_Y), false;
+    if (name == "ps") return emit(OpCode::PUSH_PS), false;
+    if (name == "t") return emit(OpCode::PUSH_T), false;
+    if (name == "pi") return emit(OpCode::PUSH_CONST, 3.1415927410125732f), false;
+    if (name == "true") return emit(OpCode::PUSH_CONST, 1.0f), true;
+    if (name == "false") return emit(OpCode::PUSH_CONST, 0.0f), true;
+
+    struct Function {
+      const char* name;
+      OpCode op;
+      int argumentCount;
+      bool isBoolean;
+    };
+
+    static const Function functions[] = {
+        {"abs", OpCode::ABS, 1, false},
+        {"sqrt", OpCode::SQRT, 1, false},
+        {"sin", OpCode::SIN, 1, false},
+        {"cos", OpCode::COS, 1, false},
+        {"tan", OpCode::TAN, 1, false},
+        {"cot", OpCode::COT, 1, false},
+        {"exp", OpCode::EXP, 1, false},
+        {"log", OpCode::LOG, 1, false},
+        {"pow", OpCode::POW, 2, false},
+        {"isEqualApprox", OpCode::IS_EQUAL_APPROX, 3, true},
+    };
+
+    for (const auto& function : functions) {
+      if (name != function.name) continue;
+
+      expect("(");
+      for (int i = 0; i < function.argumentCount; i++) {
+        if (i > 0) expect(",");
+        parseOr();
+      }
+      expect(")");
+
+      emit(function.op);
+      return function.isBoolean;
+    }
+
+    fail("Unknown identifier \"" + name + "\"");
+  }
+};
+
+int stackEffect(OpCode op) {
+  switch (op) {
+    case OpCode::PUSH_X:
+    case OpCode::PUSH_Y:
+    case OpCode::PUSH_PS:
+    case OpCode::PUSH_T:
+    case OpCode::PUSH_CONST:
+      return 1;
+    case OpCode::NEG:
+    case OpCode::NOT:
+    case OpCode::ABS:
+    case OpCode::SQRT:
+    case OpCode::SIN:
+    case OpCode::COS:
+    case OpCode::TAN:
+    case OpCode::COT:
+    case OpCode::EXP:
+    case OpCode::LOG:
+      return 0;
+    case OpCode::IS_EQUAL_APPROX:
+      return -2;
+    default:
+      return -1;
+  }
+}
+
+template <typename Function>
+void unary(float* a, std::size_t count, Function function) {
+  for (std::size_t i = 0; i < count; i++) a[i] = function(a[i]);
+}
+
+template <typename Function>
+void binary(float* a, const float* b, std::size_t count, Function function) {
+  for (std::size_t i = 0; i < count; i++) a[i] = function(a[i], b[i]);
+}
+
+}  // namespace
+
+Expression::Expression(const std::string& source) {
+  Parser parser(source);
+  resultIsBoolean = parser.parse();
+  instructions = std::move(parser.instructions);
+
+  std::size_t depth = 0;
+  for (const auto& instruction : instructions) {
+    depth = static_cast<std::size_t>(static_cast<int>(depth) +
+                                     stackEffect(instruction.op));
+    maxStackDepth = std::max(maxStackDepth, depth);
+  }
+}
+
+const std::vector<Instruction>& Expression::getInstructions() const {
+  return instructions;
+}
+
+std::size_t Expression::getMaxStackDepth() const { return maxStackDepth; }
+
+std::size_t Expression::hash() const {
+  std::uint64_t hash = 14695981039346656037ull;
+  for (const auto& instruction : instructions) {
+    std::uint32_t bits;
+    static_assert(sizeof(bits) == sizeof(instruction.value));
+    std::memcpy(&bits, &instruction.value, sizeof(bits));
+    for (std::uint64_t word : {static_cast<std::uint64_t>(instruction.op),
+                               static_cast<std::uint64_t>(bits)}) {
+      hash ^= word;
+      hash *= 1099511628211ull;
+    }
+  }
+  return static_cast<std::size_t>(hash);
+}
+
+bool Expression::isBoolean() const { return resultIsBoolean; }
+
+bool Expression::usesX() const {
+  return std::any_of(instructions.begin(), instructions.end(),
+                     [](const Instruction& i) { return i.op == OpCode::PUSH_X; });
+}
+
+bool Expression::usesY() const {
+  return std::any_of(instructions.begin(), instructions.end(),
+                     [](const Instruction& i) { return i.op == OpCode::PUSH_Y; });
+}
+
+bool Expression::usesTime() const {
+  return std::any_of(instructions.begin(), instructions.end(),
+                     [](const Instruction& i) { return i.op == OpCode::PUSH_T; });
+}
+
+void Expression::evaluate(const EvaluationInput& input, float* out) const {
+  thread_local std::vector<float> stack;
+  stack.resize(std::max<std::size_t>(maxStackDepth, 1) * batchSize);
+
+  for (std::size_t offset = 0; offset < input.count; offset += batchSize) {
+    const std::size_t count = std::min(batchSize, input.count - offset);
+    const float* x = input.x + offset;
+    const float* y = input.y + offset;
+    std::size_t depth = 0;
+
+    // a is the slot the result goes to, b and c the operands above it.
+    for (const auto& instruction : instructions) {
+      const int effect = stackEffect(instruction.op);
+      depth = static_cast<std::size_t>(static_cast<int>(depth) + effect);
+      float* a = stack.data() + (depth - 1) * batchSize;
+      float* b = effect < 0 ? a + batchSize : nullptr;
+      float* c = effect < -1 ? b + batchSize : nullptr;
+
+      switch (instruction.op) {
+        case OpCode::PUSH_X:
+          std::copy(x, x + count, a);
+          break;
+        case OpCode::PUSH_Y:
+          std::copy(y, y + count, a);
+          break;
+        case OpCode::PUSH_PS:
+          std::fill(a, a + count, input.ps);
+          break;
+        case OpCode::PUSH_T:
+          std::fill(a, a + count, input.t);
+          break;
+        case OpCode::PUSH_CONST:
+          std::fill(a, a + count, instruction.value);
+          break;
+        case OpCode::ADD:
+          binary(a, b, count, [](float l, float r) { return l + r; });
+          break;
+        case OpCode::SUB:
+          binary(a, b, count, [](float l, float r) { return l - r; });
+          break;
+        case OpCode::MUL:
+        case OpCode::AND:
+          binary(a, b, count, [](float l, float r) { return l * r; });
+          break;
+        case OpCode::DIV:
+          binary(a, b, count, [](float l, float r) { return l / r; });
+          break;
+        case OpCode::OR:
+          binary(a, b, count, [](float l, float r) { return std::max(l, r); });
+          break;
+        case OpCode::LESS:
+          binary(a, b, count, [](float l, float r) { return l < r ? 1.0f : 0.0f; });
+          break;
+        case OpCode::LESS_EQUAL:
+          binary(a, b, count, [](float l, float r) { return l <= r ? 1.0f : 0.0f; });
+          break;
+        case OpCode::GREATER:
+          binary(a, b, count, [](float l, float r) { return l > r ? 1.0f : 0.0f; });
+          break;
+        case OpCode::GREATER_EQUAL:
+          binary(a, b, count, [](float l, float r) { return l >= r ? 1.0f : 0.0f; });
+          break;
+        case OpCode::EQUAL:
+          binary(a, b, count, [](float l, float r) {
+            return std::isless(l, r) || std::isgreater(l, r) ||
+                           std::isunordered(l, r)
+                       ? 0.0f
+                       : 1.0f;
+          });
+          break;
+        case OpCode::NOT_EQUAL:
+          binary(a, b, count, [](float l, float r) {
+            return std::isless(l, r) || std::isgreater(l, r) ||
+                           std::isunordered(l, r)
+                       ? 1.0f
+                       : 0.0f;
+          });
+          break;
+        case OpCode::POW:
+          vmath::pow(a, b, count);
+          break;
+        case OpCode::NEG:
+          unary(a, count, [](float v) { return -v; });
+          break;
+        case OpCode::NOT:
+          unary(a, count, [](float v) { return 1.0f - v; });
+          break;
+        case OpCode::ABS:
+          unary(a, count, [](float v) { return std::abs(v); });
+          break;
+        case OpCode::SQRT:
+          unary(a, count, [](float v) { return std::sqrt(v); });
+          break;
+        case OpCode::SIN:
+          vmath::sin(a, count);
+          break;
+        case OpCode::COS:
+          vmath::cos(a, count);
+          break;
+        case OpCode::TAN:
+          vmath::tan(a, count);
+          break;
+        case OpCode::COT:
+          vmath::cot(a, count);
+          break;
+        case OpCode::EXP:
+          vmath::exp(a, count);
+          break;
+        case OpCode::LOG:
+          vmath::log(a, count);
+          break;
+        case OpCode::IS_EQUAL_APPROX:
+          for (std::size_t i = 0; i < count; i++)
+            a[i] = std::abs(a[i] - b[i]) <= c[i] * 0.5f ? 1.0f : 0.0f;
+          break;
+      }
+    }
+
+    const float* top = stack.data() + (depth - 1) * batchSize;
+    std::copy(top, top + count, out + offset);
+  }
+}
@@ -0,0 +1,70 @@
+#include <SGC/frame_pacer.hpp>
+
+FramePacer::~FramePacer() { release(); }
+
+void FramePacer::addInput(double time) {
+  if (inputTime < 0.0) inputTime = time;
+}
+
+void FramePacer::beginFrame() { retireFrames(isLowLatency); }
+
+void FramePacer::endFrame() {
+  if (pendingFrames.size() == maxPendingFrames) {
+    deleteFrame(pendingFrames.front());
+    pendingFrames.pop_front();
+  }
+
+  PendingFrame frame;
+  frame.inputTime = inputTime;
+  frame.submitTime = glfwGetTime();
+  glGetInteger64v(GL_TIMESTAMP, &frame.gpuSubmitTime);
+
+  glGenQueries(1, &frame.timestampQuery);
+  glQueryCounter(frame.timestampQuery, GL_TIMESTAMP);
+  frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  pendingFrames.push_back(frame);
+  inputTime = -1.0;
+}
+
+float FramePacer::getLatency() const { return latency; }
+
+void FramePacer::release() {
+  for (const auto& frame : pendingFrames) deleteFrame(frame);
+  pendingFrames.clear();
+}
+
+void FramePacer::retireFrames(bool shouldWait) {
+  constexpr GLuint64 waitTimeout = 100'000'000;
+
+  // Waiting includes the newest frame, so no frame is in flight while the
+  // next one samples input and at most one is queued after its swap.
+  while (!pendingFrames.empty()) {
+    const PendingFrame& frame = pendingFrames.front();
+
+    const GLenum status = glClientWaitSync(
+        frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT, shouldWait ? waitTimeout : 0);
+    if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED) return;
+
+    if (frame.inputTime >= 0.0) {
+      GLint64 gpuDoneTime = 0;
+      glGetQueryObjecti64v(frame.timestampQuery, GL_QUERY_RESULT,
+                           &gpuDoneTime);
+
+      const double doneTime =
+          frame.submitTime +
+          static_cast<double>(gpuDoneTime - frame.gpuSubmitTime) * 1e-9;
+      const float frameLatency =
+          static_cast<float>((doneTime - frame.inputTime) * 1000.0);
+      latency += (frameLatency - latency) * 0.2f;
+    }
+
+    deleteFrame(frame);
+    pendingFrames.pop_front();
+  }
+}
+
+void FramePacer::deleteFrame(const PendingFrame& frame) {
+  glDeleteSync(frame.fence);
+  glDeleteQueries(1, &frame.timestampQuery);
+}
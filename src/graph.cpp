@@ -1,4 +1,6 @@
 #include <SGC/graph.hpp>
+#include <cctype>
+#include <vector>
 
 Graph::Graph(bool isFunctional, std::string name, std::string body, float r,
              float g, float b, float thickness)
@@ -25,4 +27,165 @@ std::string Graph::getGraphShaderPart() const {
            std::to_string(g) + "," + std::to_string(b) +
            ", 1.0);"
            "else ";
+}
+
+namespace {
+
+std::string trim(const std::string& text) {
+  const std::size_t begin = text.find_first_not_of(" \t\n");
+  if (begin == std::string::npos) return "";
+
+  return text.substr(begin, text.find_last_not_of(" \t\n") - begin + 1);
+}
+
+// Splits the arguments of a call covering the whole body, like
+// isEqualApprox(a, b, c). Returns false if the body is not such a call.
+bool splitCall(const std::string& body, const std::string& name,
+               std::vector<std::string>& arguments) {
+  const std::string text = trim(body);
+  if (text.compare(0, name.size(), name) != 0) return false;
+
+  std::size_t i = text.find_first_not_of(" \t\n", name.size());
+  if (i == std::string::npos || text[i] != '(' || text.back() != ')')
+    return false;
+
+  arguments.clear();
+  std::size_t begin = i + 1;
+  int depth = 0;
+
+  for (i++; i < text.size() - 1; i++) {
+    if (text[i] == '(') depth++;
+    if (text[i] == ')' && --depth < 0) return false;
+
+    if (text[i] == ',' && depth == 0) {
+      arguments.push_back(trim(text.substr(begin, i - begin)));
+      begin = i + 1;
+    }
+  }
+
+  if (depth != 0) return false;
+
+  arguments.push_back(trim(text.substr(begin, text.size() - 1 - begin)));
+  return true;
+}
+
+// Splits a body with exactly one top level <, <=, > or >= and no other top
+// level logical operator.
+bool splitComparison(const std::string& body, std::string& lhs,
+                     std::string& op, std::string& rhs) {
+  std::size_t opBegin = std::string::npos;
+  std::size_t opEnd = 0;
+  int depth = 0;
+
+  for (std::size_t i = 0; i < body.size(); i++) {
+    const char c = body[i];
+    const char next = i + 1 < body.size() ? body[i + 1] : '\0';
+
+    if (c == '(') depth++;
+    if (c == ')') depth--;
+    if (depth != 0) continue;
+
+    if (c == '&' || c == '|' || c == '^' || c == '?' || c == ',' ||
+        (c == '=' && next == '=') || (c == '!' && next == '='))
+      return false;
+
+    if (c == '<' || c == '>') {
+      if (opBegin != std::string::npos) return false;
+
+      opBegin = i;
+      opEnd = next == '=' ? i + 2 : i + 1;
+      i = opEnd - 1;
+    }
+  }
+
+  if (opBegin == std::string::npos) return false;
+
+  lhs = trim(body.substr(0, opBegin));
+  op = body.substr(opBegin, opEnd - opBegin);
+  rhs = trim(body.substr(opEnd));
+
+  return !lhs.empty() && !rhs.empty();
+}
+
+bool hasIdentifier(const std::string& body, char name) {
+  auto isIdentifierChar = [](char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+  };
+
+  for (std::size_t i = 0; i < body.size(); i++) {
+    if (!isIdentifierChar(body[i])) continue;
+
+    std::size_t begin = i;
+    while (i < body.size() && isIdentifierChar(body[i])) i++;
+
+    if (i - begin == 1 && body[begin] == name) return true;
+  }
+
+  return false;
+}
+
+}  // namespace
+
+std::string Graph::getCoverageShaderPart() const {
+  std::string coverage;
+  std::vector<std::string> arguments;
+  std::string lhs;
+  std::string op;
+  std::string rhs;
+
+  if (isFunctional)
+    coverage = "lineCoverage((" + body + ") - worldPos.y, " +
+               std::to_string(thickness * 0.5f) + ")";
+  else if (splitCall(body, "isEqualApprox", arguments) &&
+           arguments.size() == 3)
+    coverage = "bandCoverage((" + arguments[0] + ") - (" + arguments[1] +
+               "), (" + arguments[2] + ") * 0.5)";
+  else if (splitComparison(body, lhs, op, rhs))
+    coverage = op[0] == '<'
+                   ? "regionCoverage((" + lhs + ") - (" + rhs + "))"
+                   : "regionCoverage((" + rhs + ") - (" + lhs + "))";
+  else
+    coverage = "((" + body + ") ? 1.0 : 0.0)";
+
+  return "result = blendUnder(result, vec3(" + std::to_string(r) + "," +
+         std::to_string(g) + "," + std::to_string(b) + "), " + coverage +
+         ");";
+}
+
+std::string Graph::getBoundaryValue() const {
+  std::vector<std::string> arguments;
+  std::string lhs;
+  std::string op;
+  std::string rhs;
+
+  if (isFunctional) return "(" + body + ") - y";
+
+  if (splitCall(body, "isEqualApprox", arguments) && arguments.size() == 3)
+    return "(" + arguments[0] + ") - (" + arguments[1] + ")";
+
+  if (splitComparison(body, lhs, op, rhs))
+    return "(" + lhs + ") - (" + rhs + ")";
+
+  return "";
+}
+
+std::string Graph::getBandWidth() const {
+  std::vector<std::string> arguments;
+
+  if (!isFunctional && splitCall(body, "isEqualApprox", arguments) &&
+      arguments.size() == 3)
+    return "(" + arguments[2] + ")";
+
+  return "";
+}
+
+bool Graph::usesTime() const { return hasIdentifier(body, 't'); }
+
+bool Graph::usesY() const { return hasIdentifier(body, 'y'); }
+
+bool Graph::usesParameter() const { return hasIdentifier(body, 'a'); }
+
+bool Graph::isColumnConstant() const {
+  return type == GraphType::PLAIN && isFunctional && !usesY() &&
+         !usesParameter();
 }
\ No newline at end of file
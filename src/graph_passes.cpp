@@ -0,0 +1,205 @@
+#include <SGC/error.hpp>
+#include <SGC/graph_passes.hpp>
+#include <SGC/graph_shader.hpp>
+#include <SGC/interval.hpp>
+#include <SGC/shader.hpp>
+#include <algorithm>
+
+GraphPasses::~GraphPasses() { release(); }
+
+bool GraphPasses::PixelRect::isEmpty() const { return x0 >= x1 || y0 >= y1; }
+
+GraphPasses::PixelRect GraphPasses::PixelRect::intersect(
+    const PixelRect& other) const {
+  return {std::max(x0, other.x0), std::max(y0, other.y0),
+          std::min(x1, other.x1), std::min(y1, other.y1)};
+}
+
+GraphPasses::PixelRect GraphPasses::PixelRect::unite(
+    const PixelRect& other) const {
+  if (isEmpty()) return other;
+  if (other.isEmpty()) return *this;
+  return {std::min(x0, other.x0), std::min(y0, other.y0),
+          std::max(x1, other.x1), std::max(y1, other.y1)};
+}
+
+bool GraphPasses::setGraphs(const std::vector<Graph>& graphs,
+                            bool isCoverageShading) {
+  std::vector<Pass> newPasses;
+
+  for (const auto& graph : graphs) {
+    const std::string fragmentSource =
+        isCoverageShading
+            ? coverageFragmentShaderSourceStart +
+                  graph.getCoverageShaderPart() +
+                  coverageFragmentShaderSourceEnd
+            : fragmentShaderSourceStart + graph.getGraphShaderPart() +
+                  fragmentShaderSourceEnd;
+    const GLuint program =
+        makeProgram(vertexShaderSource.c_str(), fragmentSource.c_str());
+
+    if (program == 0) {
+      for (const auto& pass : newPasses) glDeleteProgram(pass.program);
+      return false;
+    }
+
+    Pass pass;
+    pass.program = program;
+    pass.isFunctional = graph.isFunctional;
+    pass.thickness = graph.thickness;
+
+    try {
+      pass.expression = std::make_shared<const Expression>(graph.body);
+    } catch (const SGCError&) {
+      pass.expression = nullptr;
+    }
+
+    newPasses.push_back(std::move(pass));
+  }
+
+  releasePasses();
+  passes = std::move(newPasses);
+
+  return true;
+}
+
+void GraphPasses::draw(const std::vector<View>& views) {
+  // Passes are clipped inside the scissor rectangle of the caller, if any.
+  const bool isScissored = glIsEnabled(GL_SCISSOR_TEST) == GL_TRUE;
+  GLint scissorBox[4];
+  glGetIntegerv(GL_SCISSOR_BOX, scissorBox);
+
+  const PixelRect scissor{scissorBox[0], scissorBox[1],
+                          scissorBox[0] + scissorBox[2],
+                          scissorBox[1] + scissorBox[3]};
+
+  glEnable(GL_SCISSOR_TEST);
+  glEnable(GL_BLEND);
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                      GL_ONE_MINUS_SRC_ALPHA);
+
+  std::size_t coveredPixels = 0;
+  std::size_t viewPixels = 0;
+
+  for (const auto& view : views)
+    viewPixels += static_cast<std::size_t>(view.width) *
+                  static_cast<std::size_t>(view.height);
+
+  for (auto pass = passes.rbegin(); pass != passes.rend(); pass++) {
+    // One scissor around the bounds in every view, the views are instances
+    // of one draw.
+    PixelRect bounds{0, 0, 0, 0};
+
+    for (const auto& view : views) {
+      const PixelRect viewBounds = getBounds(*pass, view);
+      PixelRect screenBounds{
+          viewBounds.x0 + view.originX, viewBounds.y0 + view.originY,
+          viewBounds.x1 + view.originX, viewBounds.y1 + view.originY};
+
+      if (isScissored) screenBounds = screenBounds.intersect(scissor);
+
+      if (screenBounds.isEmpty()) continue;
+
+      coveredPixels += static_cast<std::size_t>(screenBounds.x1 -
+                                                screenBounds.x0) *
+                       static_cast<std::size_t>(screenBounds.y1 -
+                                                screenBounds.y0);
+      bounds = bounds.unite(screenBounds);
+    }
+
+    if (bounds.isEmpty()) continue;
+
+    glScissor(bounds.x0, bounds.y0, bounds.x1 - bounds.x0,
+              bounds.y1 - bounds.y0);
+
+    glUseProgram(pass->program);
+
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0,
+                            static_cast<GLsizei>(views.size()));
+  }
+
+  coverage = static_cast<float>(coveredPixels) /
+             static_cast<float>(std::max<std::size_t>(viewPixels, 1));
+
+  glDisable(GL_BLEND);
+  glScissor(scissorBox[0], scissorBox[1], scissorBox[2], scissorBox[3]);
+  if (!isScissored) glDisable(GL_SCISSOR_TEST);
+  glUseProgram(0);
+}
+
+void GraphPasses::release() { releasePasses(); }
+
+float GraphPasses::getCoverage() const { return coverage; }
+
+bool GraphPasses::mayCover(const Pass& pass, const View& view,
+                           const PixelRect& cell) const {
+  // Pixel centers of the cell, as the fragment shader computes worldPos.
+  const float pixelSize = 1.0f / view.zoom;
+  auto toWorld = [&](int pixel, int extent, float position) {
+    return (static_cast<double>(pixel) + 0.5 - extent * 0.5) * pixelSize +
+           position;
+  };
+
+  const Interval x{toWorld(cell.x0, view.width, view.positionX),
+                   toWorld(cell.x1 - 1, view.width, view.positionX)};
+  const Interval y{toWorld(cell.y0, view.height, view.positionY),
+                   toWorld(cell.y1 - 1, view.height, view.positionY)};
+
+  const Interval value =
+      evaluateInterval(*pass.expression, {x, y, pixelSize, view.t});
+
+  if (value.isEmpty()) return false;
+
+  if (!pass.isFunctional) return value.lo < 0.0 || value.hi > 0.0;
+
+  const double halfThickness = pixelSize * pass.thickness * 0.5;
+  return value.lo - halfThickness <= y.hi && value.hi + halfThickness >= y.lo;
+}
+
+void GraphPasses::addBounds(const Pass& pass, const View& view,
+                            const PixelRect& cell, PixelRect& bounds) const {
+  const bool isInside = cell.x0 >= bounds.x0 && cell.y0 >= bounds.y0 &&
+                        cell.x1 <= bounds.x1 && cell.y1 <= bounds.y1;
+
+  if (isInside || !mayCover(pass, view, cell)) return;
+
+  const int width = cell.x1 - cell.x0;
+  const int height = cell.y1 - cell.y0;
+
+  if (width <= minCellSize && height <= minCellSize) {
+    bounds = bounds.unite(cell);
+    return;
+  }
+
+  if (width >= height) {
+    const int middle = cell.x0 + width / 2;
+    addBounds(pass, view, {cell.x0, cell.y0, middle, cell.y1}, bounds);
+    addBounds(pass, view, {middle, cell.y0, cell.x1, cell.y1}, bounds);
+  } else {
+    const int middle = cell.y0 + height / 2;
+    addBounds(pass, view, {cell.x0, cell.y0, cell.x1, middle}, bounds);
+    addBounds(pass, view, {cell.x0, middle, cell.x1, cell.y1}, bounds);
+  }
+}
+
+GraphPasses::PixelRect GraphPasses::getBounds(const Pass& pass,
+                                              const View& view) const {
+  const PixelRect screen{0, 0, view.width, view.height};
+
+  if (!pass.expression) return screen;
+
+  PixelRect bounds{0, 0, 0, 0};
+  addBounds(pass, view, screen, bounds);
+
+  if (bounds.isEmpty()) return bounds;
+
+  // One pixel of margin for float differences between the CPU and the GPU.
+  return {std::max(bounds.x0 - 1, 0), std::max(bounds.y0 - 1, 0),
+          std::min(bounds.x1 + 1, view.width),
+          std::min(bounds.y1 + 1, view.height)};
+}
+
+void GraphPasses::releasePasses() {
+  for (const auto& pass : passes) glDeleteProgram(pass.program);
+  passes.clear();
+}
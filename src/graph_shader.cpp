@@ -0,0 +1,132 @@
+#include <SGC/graph_shader.hpp>
+
+namespace {
+
+// Every instance of the quad draws one view into its rectangle in normalized
+// device coordinates. In a parameter sweep every instance is a cell of the
+// first view instead.
+const std::string frameBlockSource =                //
+    "struct ViewData {"                             //
+    "  vec4 rect;"                                  //
+    "  vec2 windowSize;"                            //
+    "  vec2 position;"                              //
+    "  vec2 jitter;"                                //
+    "  float zoom;"                                 //
+    "  float t;"                                    //
+    "  float parameter;"                            //
+    "};"                                            //
+    "layout (std140, binding = 0) uniform Frame {"  //
+    "  ViewData views[4];"                          //
+    "  int sampleStep;"                             //
+    "  int skipStep;"                               //
+    "  int cellCount;"                              //
+    "};";
+
+}  // namespace
+
+const std::string vertexShaderSource =                                   //
+    "#version 430 core\n"                                                //
+    "layout (location = 0) in vec2 attribPos;"                           //
+    "layout (location = 1) in vec4 cellRect;"                            //
+    "layout (location = 2) in float cellParameter;"                      //
+    "out vec2 fragPos;"                                                  //
+    "flat out int viewIndex;"                                            //
+    "flat out float parameter;" +                                        //
+    frameBlockSource +                                                   //
+    "void main() {"                                                      //
+    "  viewIndex = cellCount > 0 ? 0 : gl_InstanceID;"                   //
+    "  vec4 rect = cellCount > 0 ? cellRect : views[viewIndex].rect;"    //
+    "  gl_Position ="                                                    //
+    "    vec4(mix(rect.xy, rect.zw, attribPos * 0.5 + 0.5), 0.0, 1.0);"  //
+    "  fragPos = attribPos;"                                             //
+    "  parameter ="                                                      //
+    "    cellCount > 0 ? cellParameter : views[viewIndex].parameter;"    //
+    "}";
+
+namespace {
+
+// Declarations and the start of main up to the pixel position.
+const std::string fragmentHeadSource =                                   //
+    "#version 430 core\n"                                                //
+    "#define pi 3.1415927410125732\n"                                    //
+    "in vec2 fragPos;"                                                   //
+    "flat in int viewIndex;"                                             //
+    "flat in float parameter;"                                           //
+    "out vec4 FragColor;" +                                              //
+    frameBlockSource +                                                   //
+    "bool isEqualApprox(float a, float b, float c) {"                    //
+    "  return abs(a - b) <= c * 0.5;"                                    //
+    "}"                                                                  //
+    "float getCoverage(float distance) {"                                //
+    "  return isnan(distance) ? 0.0 : clamp(distance, 0.0, 1.0);"        //
+    "}"                                                                  //
+    "float getGradient(float value) {"                                   //
+    "  return max(length(vec2(dFdx(value), dFdy(value))), 1e-30);"       //
+    "}"                                                                  //
+    "float lineCoverage(float value, float halfWidth) {"                 //
+    "  float distance = abs(value) / getGradient(value);"                //
+    "  return getCoverage(halfWidth + 0.5 - distance);"                  //
+    "}"                                                                  //
+    "float bandCoverage(float value, float halfBand) {"                  //
+    "  float gradient = getGradient(value);"                             //
+    "  return getCoverage((halfBand - abs(value)) / gradient + 0.5);"    //
+    "}"                                                                  //
+    "float regionCoverage(float value) {"                                //
+    "  return getCoverage(0.5 - value / getGradient(value));"            //
+    "}"                                                                  //
+    "vec4 blendUnder(vec4 result, vec3 color, float coverage) {"         //
+    "  return result + (1.0 - result.a) * vec4(color, 1.0) * coverage;"  //
+    "}"                                                                  //
+    "bool isSample(ivec2 pixel) {"                                       //
+    "  return all(equal(pixel % sampleStep, ivec2(0))) &&"               //
+    "    !(skipStep > 0 && all(equal(pixel % skipStep, ivec2(0))));"     //
+    "}"                                                                  //
+    "void main() {"                                                      //
+    "  ivec2 pixel = ivec2(gl_FragCoord.xy);";
+
+// Camera values and the world position of the pixel.
+const std::string fragmentMainSource =                         //
+    "  vec2 windowSize = views[viewIndex].windowSize;"         //
+    "  vec2 position = views[viewIndex].position;"             //
+    "  vec2 jitter = views[viewIndex].jitter;"                 //
+    "  float zoom = views[viewIndex].zoom;"                    //
+    "  float t = views[viewIndex].t;"                          //
+    "  float a = parameter;"                                   //
+    "  float pixelSize = 1.0 / zoom;"                          //
+    "  vec2 worldPos = (windowSize * 0.5 * fragPos + jitter)"  //
+    "    * pixelSize + position;"                              //
+    "  float x = worldPos.x;"                                  //
+    "  float y = worldPos.y;"                                  //
+    "  float ps = pixelSize;"                                  //
+    "  vec4 result = vec4(0.0);";
+
+}  // namespace
+
+// Pixels off the sample lattice of a progressive pass are discarded up front.
+const std::string fragmentShaderSourceStart =  //
+    fragmentHeadSource +                       //
+    "  if (!isSample(pixel)) discard;" +       //
+    fragmentMainSource;
+
+// Only 2x2 quads without a pixel on the sample lattice are discarded up front.
+// The other pixels off it run to the end with their quad, so the derivatives
+// of the coverage parts stay defined.
+const std::string coverageFragmentShaderSourceStart =                      //
+    fragmentHeadSource +                                                   //
+    "  ivec2 quad = pixel & ~1;"                                           //
+    "  if (!isSample(quad) && !isSample(quad + ivec2(1, 0)) &&"            //
+    "    !isSample(quad + ivec2(0, 1)) && !isSample(quad + ivec2(1, 1)))"  //
+    "    discard;"                                                         //
+    "  bool isSkipped = !isSample(pixel);" +                               //
+    fragmentMainSource;
+
+// Pixels no graph covers keep the grid drawn before the graph pass.
+const std::string fragmentShaderSourceEnd =  //
+    "  discard;"                             //
+    "}";
+
+// Coverage parts accumulate into result front to back.
+const std::string coverageFragmentShaderSourceEnd =         //
+    "  if (isSkipped || result.a <= 0.0) discard;"          //
+    "  FragColor = vec4(result.rgb / result.a, result.a);"  //
+    "}";
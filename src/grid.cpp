@@ -0,0 +1,127 @@
+#include <SGC/error.hpp>
+#include <SGC/grid.hpp>
+#include <SGC/shader.hpp>
+#include <cmath>
+
+namespace {
+
+const GLchar* gridVertexShaderSource =               //
+    "#version 430 core\n"                            //
+    "layout (location = 0) in vec2 attribPos;"       //
+    "void main() {"                                  //
+    "  gl_Position = vec4(attribPos.xy, 0.0, 1.0);"  //
+    "}";
+
+const GLchar* gridFragmentShaderSource =  //
+    "#version 430 core\n"                 //
+    "out vec4 FragColor;"                 //
+    "uniform vec3 color;"                 //
+    "void main() {"                       //
+    "  FragColor = vec4(color, 1.0);"     //
+    "}";
+
+}  // namespace
+
+Grid::~Grid() { release(); }
+
+void Grid::draw(const View& view) {
+  if (program == 0) {
+    program = makeProgram(gridVertexShaderSource, gridFragmentShaderSource);
+
+    if (program == 0)
+      throw SGCError(SGCErrorType::OPENGL_ERROR,
+                     "[OpenGL]: Failed to compile grid program.\n");
+
+    colorUniformLocation = glGetUniformLocation(program, "color");
+
+    glGenVertexArrays(1, &vertexArray);
+    glGenBuffers(1, &vertexBuffer);
+
+    glBindVertexArray(vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float),
+                          (void*)(0));
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+  }
+
+  // Later batches overwrite earlier ones: axes over sublines over microlines.
+  vertices.clear();
+  addLines(view, view.microlinePeriod, true);
+  addLines(view, view.microlinePeriod, false);
+  const GLsizei microlineCount = static_cast<GLsizei>(vertices.size() / 2);
+  addLines(view, view.sublinePeriod, true);
+  addLines(view, view.sublinePeriod, false);
+  const GLsizei sublineCount =
+      static_cast<GLsizei>(vertices.size() / 2) - microlineCount;
+  addLines(view, 0.0f, true);
+  addLines(view, 0.0f, false);
+  const GLsizei axisCount = static_cast<GLsizei>(vertices.size() / 2) -
+                            microlineCount - sublineCount;
+
+  glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT);
+
+  glBindVertexArray(vertexArray);
+  glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+
+  const GLsizeiptr size =
+      static_cast<GLsizeiptr>(vertices.size() * sizeof(GLfloat));
+
+  if (size > vertexBufferSize) {
+    glBufferData(GL_ARRAY_BUFFER, size, vertices.data(), GL_STREAM_DRAW);
+    vertexBufferSize = size;
+  } else
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, vertices.data());
+
+  glUseProgram(program);
+
+  glUniform3f(colorUniformLocation, 0.85f, 0.85f, 0.85f);
+  glDrawArrays(GL_LINES, 0, microlineCount);
+  glUniform3f(colorUniformLocation, 0.65f, 0.65f, 0.65f);
+  glDrawArrays(GL_LINES, microlineCount, sublineCount);
+  glUniform3f(colorUniformLocation, 0.0f, 0.0f, 0.0f);
+  glDrawArrays(GL_LINES, microlineCount + sublineCount, axisCount);
+
+  glBindVertexArray(0);
+  glUseProgram(0);
+}
+
+void Grid::release() {
+  if (program != 0) glDeleteProgram(program);
+  if (vertexBuffer != 0) glDeleteBuffers(1, &vertexBuffer);
+  if (vertexArray != 0) glDeleteVertexArrays(1, &vertexArray);
+  program = 0;
+  vertexBuffer = 0;
+  vertexArray = 0;
+  vertexBufferSize = 0;
+}
+
+void Grid::addLines(const View& view, float period, bool isVertical) {
+  const double extent = isVertical ? view.width : view.height;
+  const double position = isVertical ? view.positionX : view.positionY;
+  const double halfSize = extent * 0.5 / view.zoom;
+
+  // Lines up to half a pixel outside still touch the edge pixels. A period
+  // of 0 is the axis.
+  const double margin = 0.5 / view.zoom;
+  const double begin =
+      period > 0.0f ? std::ceil((position - halfSize - margin) / period) : 0.0;
+  const double end =
+      period > 0.0f ? std::floor((position + halfSize + margin) / period) : 0.0;
+
+  if (period <= 0.0f && std::abs(position) > halfSize + margin) return;
+
+  // Guards against periods far below a pixel, which would draw solid color.
+  if (end - begin > extent) return;
+
+  for (double k = begin; k <= end; k++) {
+    const GLfloat ndc =
+        static_cast<GLfloat>((k * period - position) / halfSize);
+
+    if (isVertical)
+      vertices.insert(vertices.end(), {ndc, -1.0f, ndc, 1.0f});
+    else
+      vertices.insert(vertices.end(), {-1.0f, ndc, 1.0f, ndc});
+  }
+}
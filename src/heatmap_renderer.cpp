@@ -0,0 +1,399 @@
+#include <SGC/camera_block.hpp>
+#include <SGC/error.hpp>
+#include <SGC/heatmap_renderer.hpp>
+#include <SGC/shader.hpp>
+#include <algorithm>
+#include <string>
+
+namespace {
+
+constexpr int colormapCount = 4;
+
+// Work groups are 16x16 pixels, the range of a group is reduced in shared
+// memory. Values that are not finite are left out of the range.
+const std::string evaluateSourceStart =                             //
+    "#version 430 core\n"                                           //
+    "#define pi 3.1415927410125732\n"                               //
+    "layout (local_size_x = 16, local_size_y = 16) in;"             //
+    "layout (r32f, binding = 0) writeonly uniform image2D values;"  //
+    "layout (std430, binding = 0) writeonly buffer GroupRanges {"   //
+    "  vec2 groupRanges[];"                                         //
+    "};" +                                                          //
+    std::string(cameraBlockSource) +                                //
+    "shared vec2 sharedRanges[256];"                                //
+    "bool isEqualApprox(float a, float b, float c) {"               //
+    "  return abs(a - b) <= c * 0.5;"                               //
+    "}"                                                             //
+    "float evaluate(vec2 worldPos) {"                               //
+    "  float x = worldPos.x;"                                       //
+    "  float y = worldPos.y;"                                       //
+    "  float ps = 1.0 / zoom;"                                      //
+    "  return float(";
+
+const std::string evaluateSourceEnd =                                   //
+    ");"                                                                //
+    "}"                                                                 //
+    "void main() {"                                                     //
+    "  ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);"                  //
+    "  vec2 range = vec2(3.4e38, -3.4e38);"                             //
+    "  if (all(lessThan(pixel, ivec2(windowSize)))) {"                  //
+    "    float value = evaluate("                                       //
+    "      (vec2(pixel) + 0.5 - windowSize * 0.5) / zoom + position);"  //
+    "    imageStore(values, pixel, vec4(value));"                       //
+    "    if (!isnan(value) && !isinf(value)) range = vec2(value);"      //
+    "  }"                                                               //
+    "  uint index = gl_LocalInvocationIndex;"                           //
+    "  sharedRanges[index] = range;"                                    //
+    "  barrier();"                                                      //
+    "  for (uint stride = 128u; stride > 0u; stride >>= 1) {"           //
+    "    if (index < stride) {"                                         //
+    "      vec2 other = sharedRanges[index + stride];"                  //
+    "      sharedRanges[index] = vec2(min(sharedRanges[index].x,"       //
+    "        other.x), max(sharedRanges[index].y, other.y));"           //
+    "    }"                                                             //
+    "    barrier();"                                                    //
+    "  }"                                                               //
+    "  if (index == 0u)"                                                //
+    "    groupRanges[gl_WorkGroupID.y * gl_NumWorkGroups.x"             //
+    "      + gl_WorkGroupID.x] = sharedRanges[0];"                      //
+    "}";
+
+// One work group reduces the group ranges into the range of a heatmap.
+const GLchar* reduceSource =                                       //
+    "#version 430 core\n"                                          //
+    "layout (local_size_x = 256) in;"                              //
+    "layout (std430, binding = 0) readonly buffer GroupRanges {"   //
+    "  vec2 groupRanges[];"                                        //
+    "};"                                                           //
+    "layout (std430, binding = 1) writeonly buffer Ranges {"       //
+    "  vec2 ranges[];"                                             //
+    "};"                                                           //
+    "uniform int groupCount;"                                      //
+    "uniform int rangeIndex;"                                      //
+    "shared vec2 sharedRanges[256];"                               //
+    "void main() {"                                                //
+    "  uint index = gl_LocalInvocationIndex;"                      //
+    "  vec2 range = vec2(3.4e38, -3.4e38);"                        //
+    "  for (uint i = index; i < uint(groupCount); i += 256u)"      //
+    "    range = vec2(min(range.x, groupRanges[i].x),"             //
+    "      max(range.y, groupRanges[i].y));"                       //
+    "  sharedRanges[index] = range;"                               //
+    "  barrier();"                                                 //
+    "  for (uint stride = 128u; stride > 0u; stride >>= 1) {"      //
+    "    if (index < stride) {"                                    //
+    "      vec2 other = sharedRanges[index + stride];"             //
+    "      sharedRanges[index] = vec2(min(sharedRanges[index].x,"  //
+    "        other.x), max(sharedRanges[index].y, other.y));"      //
+    "    }"                                                        //
+    "    barrier();"                                               //
+    "  }"                                                          //
+    "  if (index == 0u) ranges[rangeIndex] = sharedRanges[0];"     //
+    "}";
+
+const GLchar* compositeVertexShaderSource =                     //
+    "#version 430 core\n"                                       //
+    "void main() {"                                             //
+    "  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);"  //
+    "  gl_Position = vec4(corner * 4.0 - 1.0, 0.0, 1.0);"       //
+    "}";
+
+// Diverging colormaps are centered on 0 with the larger side of the range.
+const std::string compositeFragmentShaderSource =                        //
+    "#version 430 core\n"                                                //
+    "out vec4 FragColor;"                                                //
+    "layout (std430, binding = 1) readonly buffer Ranges {"              //
+    "  vec2 ranges[];"                                                   //
+    "};" +                                                               //
+    std::string(cameraBlockSource) +                                     //
+    "uniform sampler2D values;"                                          //
+    "uniform sampler1DArray colormaps;"                                  //
+    "uniform int rangeIndex;"                                            //
+    "uniform int colormap;"                                              //
+    "uniform bool isDiverging;"                                          //
+    "uniform float opacity;"                                             //
+    "void main() {"                                                      //
+    "  ivec2 pixel = ivec2(gl_FragCoord.xy) - origin;"                   //
+    "  float value = texelFetch(values, pixel, 0).r;"                    //
+    "  vec2 range = ranges[rangeIndex];"                                 //
+    "  if (isnan(value) || isinf(value) || range.x > range.y) discard;"  //
+    "  if (isDiverging)"                                                 //
+    "    range = vec2(-1.0, 1.0) * max(abs(range.x), abs(range.y));"     //
+    "  float level = range.y > range.x"                                  //
+    "    ? clamp((value - range.x) / (range.y - range.x), 0.0, 1.0)"     //
+    "    : 0.5;"                                                         //
+    "  float u = (level * 255.0 + 0.5) / 256.0;"                         //
+    "  vec3 color = texture(colormaps, vec2(u, float(colormap))).rgb;"   //
+    "  FragColor = vec4(color, opacity);"                                //
+    "}";
+
+// Polynomial fits of viridis and turbo, coolwarm is interpolated through a
+// light center.
+void getColormapColor(Colormap colormap, float t, float rgb[3]) {
+  switch (colormap) {
+    case Colormap::VIRIDIS: {
+      static const float c[7][3] = {
+          {0.2777273f, 0.0054073f, 0.3340998f},
+          {0.1050930f, 1.4046135f, 1.3845902f},
+          {-0.3308618f, 0.2148476f, 0.0950952f},
+          {-4.6342305f, -5.7991010f, -19.3324410f},
+          {6.2282699f, 14.1799334f, 56.6905526f},
+          {4.7763850f, -13.7451454f, -65.3530326f},
+          {-5.4354559f, 4.6458526f, 26.3124352f},
+      };
+
+      for (int i = 0; i < 3; i++) {
+        float value = c[6][i];
+        for (int k = 5; k >= 0; k--) value = value * t + c[k][i];
+        rgb[i] = value;
+      }
+      break;
+    }
+    case Colormap::TURBO: {
+      static const float c[6][3] = {
+          {0.13572138f, 0.09140261f, 0.10667330f},
+          {4.61539260f, 2.19418839f, 12.64194608f},
+          {-42.66032258f, 4.84296658f, -60.58204836f},
+          {132.13108234f, -14.18503333f, 110.36276771f},
+          {-152.94239396f, 4.27729857f, -89.90310912f},
+          {59.28637943f, 2.82956604f, 27.34824973f},
+      };
+
+      for (int i = 0; i < 3; i++) {
+        float value = c[5][i];
+        for (int k = 4; k >= 0; k--) value = value * t + c[k][i];
+        rgb[i] = value;
+      }
+      break;
+    }
+    case Colormap::COOLWARM: {
+      static const float cold[3] = {0.230f, 0.299f, 0.754f};
+      static const float center[3] = {0.865f, 0.865f, 0.865f};
+      static const float warm[3] = {0.706f, 0.016f, 0.150f};
+
+      const float* from = t < 0.5f ? cold : center;
+      const float* to = t < 0.5f ? center : warm;
+      const float s = t < 0.5f ? t * 2.0f : t * 2.0f - 1.0f;
+
+      for (int i = 0; i < 3; i++) rgb[i] = from[i] + (to[i] - from[i]) * s;
+      break;
+    }
+    case Colormap::GRAYSCALE:
+      rgb[0] = rgb[1] = rgb[2] = t;
+      break;
+  }
+}
+
+}  // namespace
+
+HeatmapRenderer::~HeatmapRenderer() { release(); }
+
+bool HeatmapRenderer::setGraphs(const std::vector<Graph>& graphs) {
+  std::vector<Heatmap> newHeatmaps;
+
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible || graph.type != GraphType::HEATMAP) continue;
+
+    const std::string evaluateSource =
+        evaluateSourceStart + graph.body + evaluateSourceEnd;
+    const GLuint program = makeComputeProgram(evaluateSource.c_str());
+
+    if (program == 0) {
+      for (const auto& heatmap : newHeatmaps) glDeleteProgram(heatmap.program);
+      return false;
+    }
+
+    Heatmap heatmap;
+    heatmap.program = program;
+    heatmap.colormap = graph.colormap;
+
+    newHeatmaps.push_back(heatmap);
+  }
+
+  releaseHeatmaps();
+  heatmaps = std::move(newHeatmaps);
+
+  return true;
+}
+
+void HeatmapRenderer::draw(const View& view) {
+  if (heatmaps.empty()) return;
+
+  if (reduceProgram == 0) create();
+
+  if (valuesWidth != view.width || valuesHeight != view.height) {
+    if (valuesTexture != 0) glDeleteTextures(1, &valuesTexture);
+
+    glGenTextures(1, &valuesTexture);
+    glBindTexture(GL_TEXTURE_2D, valuesTexture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32F, view.width, view.height);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    valuesWidth = view.width;
+    valuesHeight = view.height;
+  }
+
+  const int groupsX = (view.width + 15) / 16;
+  const int groupsY = (view.height + 15) / 16;
+  const GLsizeiptr groupRangesSize = static_cast<GLsizeiptr>(
+      static_cast<std::size_t>(groupsX * groupsY) * 2 * sizeof(GLfloat));
+  const GLsizeiptr rangesSize = static_cast<GLsizeiptr>(
+      heatmaps.size() * 2 * sizeof(GLfloat));
+
+  if (groupRangesSize > groupRangesBufferSize) {
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, groupRangesBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, groupRangesSize, nullptr,
+                 GL_DYNAMIC_COPY);
+    groupRangesBufferSize = groupRangesSize;
+  }
+
+  if (rangesSize > rangesBufferSize) {
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, rangesBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, rangesSize, nullptr,
+                 GL_DYNAMIC_COPY);
+    rangesBufferSize = rangesSize;
+  }
+
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, groupRangesBuffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, rangesBuffer);
+
+  glEnable(GL_BLEND);
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                      GL_ONE_MINUS_SRC_ALPHA);
+
+  glBindVertexArray(vertexArray);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, valuesTexture);
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(GL_TEXTURE_1D_ARRAY, colormapTexture);
+
+  // The values texture is reused, every heatmap is composited before the
+  // next one is evaluated.
+  for (std::size_t i = 0; i < heatmaps.size(); i++) {
+    const Heatmap& heatmap = heatmaps[i];
+
+    glBindImageTexture(0, valuesTexture, 0, GL_FALSE, 0, GL_WRITE_ONLY,
+                       GL_R32F);
+
+    glUseProgram(heatmap.program);
+    glDispatchCompute(static_cast<GLuint>(groupsX),
+                      static_cast<GLuint>(groupsY), 1);
+
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    glUseProgram(reduceProgram);
+    glUniform1i(reduceGroupCountUniformLocation, groupsX * groupsY);
+    glUniform1i(reduceRangeIndexUniformLocation, static_cast<GLint>(i));
+
+    glDispatchCompute(1, 1, 1);
+
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT |
+                    GL_TEXTURE_FETCH_BARRIER_BIT);
+
+    glUseProgram(compositeProgram);
+    glUniform1i(compositeRangeIndexUniformLocation, static_cast<GLint>(i));
+    glUniform1i(compositeColormapUniformLocation,
+                static_cast<GLint>(heatmap.colormap));
+    glUniform1i(compositeIsDivergingUniformLocation,
+                heatmap.colormap == Colormap::COOLWARM);
+
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    // The next evaluation overwrites values this composite reads.
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+  }
+
+  glBindTexture(GL_TEXTURE_1D_ARRAY, 0);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindVertexArray(0);
+  glUseProgram(0);
+  glDisable(GL_BLEND);
+}
+
+bool HeatmapRenderer::isEmpty() const { return heatmaps.empty(); }
+
+void HeatmapRenderer::release() {
+  releaseHeatmaps();
+  if (reduceProgram != 0) glDeleteProgram(reduceProgram);
+  if (compositeProgram != 0) glDeleteProgram(compositeProgram);
+  if (vertexArray != 0) glDeleteVertexArrays(1, &vertexArray);
+  if (colormapTexture != 0) glDeleteTextures(1, &colormapTexture);
+  if (valuesTexture != 0) glDeleteTextures(1, &valuesTexture);
+  if (groupRangesBuffer != 0) glDeleteBuffers(1, &groupRangesBuffer);
+  if (rangesBuffer != 0) glDeleteBuffers(1, &rangesBuffer);
+  reduceProgram = 0;
+  compositeProgram = 0;
+  vertexArray = 0;
+  colormapTexture = 0;
+  valuesTexture = 0;
+  valuesWidth = 0;
+  valuesHeight = 0;
+  groupRangesBuffer = 0;
+  groupRangesBufferSize = 0;
+  rangesBuffer = 0;
+  rangesBufferSize = 0;
+}
+
+void HeatmapRenderer::create() {
+  reduceProgram = makeComputeProgram(reduceSource);
+  compositeProgram = makeProgram(compositeVertexShaderSource,
+                                 compositeFragmentShaderSource.c_str());
+
+  if (reduceProgram == 0 || compositeProgram == 0)
+    throw SGCError(SGCErrorType::OPENGL_ERROR,
+                   "[OpenGL]: Failed to compile heatmap programs.\n");
+
+  reduceGroupCountUniformLocation =
+      glGetUniformLocation(reduceProgram, "groupCount");
+  reduceRangeIndexUniformLocation =
+      glGetUniformLocation(reduceProgram, "rangeIndex");
+  compositeRangeIndexUniformLocation =
+      glGetUniformLocation(compositeProgram, "rangeIndex");
+  compositeColormapUniformLocation =
+      glGetUniformLocation(compositeProgram, "colormap");
+  compositeIsDivergingUniformLocation =
+      glGetUniformLocation(compositeProgram, "isDiverging");
+
+  glUseProgram(compositeProgram);
+  glUniform1i(glGetUniformLocation(compositeProgram, "values"), 0);
+  glUniform1i(glGetUniformLocation(compositeProgram, "colormaps"), 1);
+  glUniform1f(glGetUniformLocation(compositeProgram, "opacity"), opacity);
+  glUseProgram(0);
+
+  std::vector<GLubyte> texels;
+
+  for (int map = 0; map < colormapCount; map++) {
+    for (int i = 0; i < colormapSize; i++) {
+      float rgb[3];
+      getColormapColor(static_cast<Colormap>(map),
+                       static_cast<float>(i) / (colormapSize - 1), rgb);
+
+      for (float channel : rgb)
+        texels.push_back(static_cast<GLubyte>(
+            std::clamp(channel, 0.0f, 1.0f) * 255.0f + 0.5f));
+      texels.push_back(255);
+    }
+  }
+
+  glGenTextures(1, &colormapTexture);
+  glBindTexture(GL_TEXTURE_1D_ARRAY, colormapTexture);
+  glTexStorage2D(GL_TEXTURE_1D_ARRAY, 1, GL_RGBA8, colormapSize,
+                 colormapCount);
+  glTexSubImage2D(GL_TEXTURE_1D_ARRAY, 0, 0, 0, colormapSize, colormapCount,
+                  GL_RGBA, GL_UNSIGNED_BYTE, texels.data());
+  glTexParameteri(GL_TEXTURE_1D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_1D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_1D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glBindTexture(GL_TEXTURE_1D_ARRAY, 0);
+
+  glGenVertexArrays(1, &vertexArray);
+  glGenBuffers(1, &groupRangesBuffer);
+  glGenBuffers(1, &rangesBuffer);
+}
+
+void HeatmapRenderer::releaseHeatmaps() {
+  for (const auto& heatmap : heatmaps) glDeleteProgram(heatmap.program);
+  heatmaps.clear();
+}
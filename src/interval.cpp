@@ -0,0 +1,291 @@
+#include <SGC/interval.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double infinity = std::numeric_limits<double>::infinity();
+constexpr double pi = 3.14159265358979323846;
+
+bool isSame(double a, double b) {
+  return !std::isless(a, b) && !std::isgreater(a, b);
+}
+
+Interval whole(bool mayBeNaN = false) {
+  return {-infinity, infinity, mayBeNaN};
+}
+
+Interval empty() { return {infinity, -infinity, true}; }
+
+Interval point(double value) { return {value, value}; }
+
+Interval boolean(bool canBeFalse, bool canBeTrue) {
+  return {canBeFalse ? 0.0 : 1.0, canBeTrue ? 1.0 : 0.0};
+}
+
+// Sums of opposite infinities and 0 * infinity give NaN bounds, which only
+// say the range is unknown.
+Interval make(double lo, double hi, bool mayBeNaN) {
+  if (std::isnan(lo) || std::isnan(hi)) return whole(mayBeNaN);
+  return {lo, hi, mayBeNaN};
+}
+
+Interval add(const Interval& a, const Interval& b) {
+  if (a.isEmpty() || b.isEmpty()) return empty();
+  return make(a.lo + b.lo, a.hi + b.hi, a.mayBeNaN || b.mayBeNaN);
+}
+
+Interval negate(const Interval& a) { return {-a.hi, -a.lo, a.mayBeNaN}; }
+
+Interval multiply(const Interval& a, const Interval& b) {
+  if (a.isEmpty() || b.isEmpty()) return empty();
+  const double products[] = {a.lo * b.lo, a.lo * b.hi, a.hi * b.lo,
+                             a.hi * b.hi};
+  for (double product : products)
+    if (std::isnan(product)) return whole(a.mayBeNaN || b.mayBeNaN);
+  return {*std::min_element(std::begin(products), std::end(products)),
+          *std::max_element(std::begin(products), std::end(products)),
+          a.mayBeNaN || b.mayBeNaN};
+}
+
+Interval divide(const Interval& a, const Interval& b) {
+  if (a.isEmpty() || b.isEmpty()) return empty();
+  if (b.lo <= 0.0 && b.hi >= 0.0) return whole(true);
+  return multiply(a, {1.0 / b.hi, 1.0 / b.lo, b.mayBeNaN});
+}
+
+Interval absolute(const Interval& a) {
+  if (a.isEmpty() || a.lo >= 0.0) return a;
+  if (a.hi <= 0.0) return negate(a);
+  return {0.0, std::max(-a.lo, a.hi), a.mayBeNaN};
+}
+
+// Applies an increasing function on the part of the interval inside the
+// domain [domainLo, inf).
+template <typename Function>
+Interval increasing(const Interval& a, double domainLo, Function function) {
+  if (a.isEmpty() || a.hi < domainLo) return empty();
+  return make(function(std::max(a.lo, domainLo)), function(a.hi),
+              a.mayBeNaN || a.lo < domainLo);
+}
+
+// sin over [lo, hi], shift moves the maximum from pi / 2 for cos.
+Interval sine(const Interval& a, double shift) {
+  if (a.isEmpty()) return empty();
+  if (!std::isfinite(a.lo) || !std::isfinite(a.hi) || a.hi - a.lo >= 2.0 * pi)
+    return {-1.0, 1.0, a.mayBeNaN};
+
+  auto containsPeak = [&](double peak) {
+    const double k = std::ceil((a.lo - peak) / (2.0 * pi));
+    return peak + k * 2.0 * pi <= a.hi;
+  };
+
+  const double lo = std::sin(a.lo + shift);
+  const double hi = std::sin(a.hi + shift);
+  return {containsPeak(-pi * 0.5 - shift) ? -1.0 : std::min(lo, hi),
+          containsPeak(pi * 0.5 - shift) ? 1.0 : std::max(lo, hi),
+          a.mayBeNaN};
+}
+
+// tan is increasing between asymptotes at pi / 2 + k * pi, cot is decreasing
+// between asymptotes at k * pi.
+Interval tangent(const Interval& a, bool isCotangent) {
+  if (a.isEmpty()) return empty();
+  if (!std::isfinite(a.lo) || !std::isfinite(a.hi)) return whole(a.mayBeNaN);
+
+  const double asymptote = isCotangent ? 0.0 : pi * 0.5;
+  const double k = std::ceil((a.lo - asymptote) / pi);
+  if (asymptote + k * pi <= a.hi) return whole(a.mayBeNaN);
+
+  if (isCotangent)
+    return {1.0 / std::tan(a.hi), 1.0 / std::tan(a.lo), a.mayBeNaN};
+  return {std::tan(a.lo), std::tan(a.hi), a.mayBeNaN};
+}
+
+Interval power(const Interval& a, const Interval& b) {
+  if (a.isEmpty() || b.isEmpty()) return empty();
+
+  // Integer exponents, like in pow(x, 2.0), are monotonic in |a| for even
+  // and in a for odd exponents. GLSL leaves negative bases undefined.
+  if (isSame(b.lo, b.hi) && isSame(b.lo, std::round(b.lo)) &&
+      std::abs(b.lo) <= 64.0) {
+    const double exponent = b.lo;
+    const bool isEven = isSame(std::fmod(exponent, 2.0), 0.0);
+    const Interval base = isEven ? absolute(a) : a;
+
+    if (exponent >= 0.0)
+      return make(std::pow(base.lo, exponent), std::pow(base.hi, exponent),
+                  a.mayBeNaN || b.mayBeNaN || a.lo < 0.0);
+  }
+
+  // exp(b * log(a)) for positive bases, other negative bases are left
+  // unbounded.
+  if (a.lo > 0.0) {
+    const Interval logarithm = increasing(a, 0.0, [](double v) {
+      return std::log(v);
+    });
+    return increasing(multiply(b, logarithm), -infinity,
+                      [](double v) { return std::exp(v); });
+  }
+
+  return whole(true);
+}
+
+Interval less(const Interval& a, const Interval& b, bool orEqual) {
+  if (a.isEmpty() || b.isEmpty()) return boolean(true, false);
+  const bool canBeTrue = orEqual ? a.lo <= b.hi : a.lo < b.hi;
+  const bool canBeFalse = orEqual ? a.hi > b.lo : a.hi >= b.lo;
+  return boolean(canBeFalse || a.mayBeNaN || b.mayBeNaN, canBeTrue);
+}
+
+Interval equal(const Interval& a, const Interval& b) {
+  if (a.isEmpty() || b.isEmpty()) return boolean(true, false);
+  const bool canBeTrue = a.lo <= b.hi && b.lo <= a.hi;
+  const bool canBeFalse = a.lo < a.hi || b.lo < b.hi || !isSame(a.lo, b.lo) ||
+                          a.mayBeNaN || b.mayBeNaN;
+  return boolean(canBeFalse, canBeTrue);
+}
+
+}  // namespace
+
+bool Interval::isEmpty() const { return !(lo <= hi); }
+
+Interval evaluateInterval(const Expression& expression,
+                          const IntervalInput& input) {
+  thread_local std::vector<Interval> stack;
+  stack.clear();
+
+  for (const auto& instruction : expression.getInstructions()) {
+    Interval value;
+
+    switch (instruction.op) {
+      case OpCode::PUSH_X:
+        stack.push_back(input.x);
+        continue;
+      case OpCode::PUSH_Y:
+        stack.push_back(input.y);
+        continue;
+      case OpCode::PUSH_PS:
+        stack.push_back(point(input.ps));
+        continue;
+      case OpCode::PUSH_T:
+        stack.push_back(point(input.t));
+        continue;
+      case OpCode::PUSH_CONST:
+        stack.push_back(point(instruction.value));
+        continue;
+      default:
+        break;
+    }
+
+    if (instruction.op == OpCode::IS_EQUAL_APPROX) {
+      const Interval c = stack.back();
+      stack.pop_back();
+      const Interval b = stack.back();
+      stack.pop_back();
+      const Interval distance = absolute(add(stack.back(), negate(b)));
+
+      if (distance.isEmpty() || c.isEmpty())
+        stack.back() = boolean(true, false);
+      else
+        stack.back() =
+            boolean(distance.hi > c.lo * 0.5 || distance.mayBeNaN ||
+                        c.mayBeNaN,
+                    distance.lo <= c.hi * 0.5);
+      continue;
+    }
+
+    Interval b{};
+    if (instruction.op != OpCode::NEG && instruction.op != OpCode::NOT &&
+        instruction.op != OpCode::ABS && instruction.op != OpCode::SQRT &&
+        instruction.op != OpCode::SIN && instruction.op != OpCode::COS &&
+        instruction.op != OpCode::TAN && instruction.op != OpCode::COT &&
+        instruction.op != OpCode::EXP && instruction.op != OpCode::LOG) {
+      b = stack.back();
+      stack.pop_back();
+    }
+
+    const Interval& a = stack.back();
+
+    switch (instruction.op) {
+      case OpCode::ADD:
+        value = add(a, b);
+        break;
+      case OpCode::SUB:
+        value = add(a, negate(b));
+        break;
+      case OpCode::MUL:
+        value = multiply(a, b);
+        break;
+      case OpCode::DIV:
+        value = divide(a, b);
+        break;
+      case OpCode::AND:
+        value = {a.lo * b.lo, a.hi * b.hi};
+        break;
+      case OpCode::OR:
+        value = {std::max(a.lo, b.lo), std::max(a.hi, b.hi)};
+        break;
+      case OpCode::LESS:
+        value = less(a, b, false);
+        break;
+      case OpCode::LESS_EQUAL:
+        value = less(a, b, true);
+        break;
+      case OpCode::GREATER:
+        value = less(b, a, false);
+        break;
+      case OpCode::GREATER_EQUAL:
+        value = less(b, a, true);
+        break;
+      case OpCode::EQUAL:
+        value = equal(a, b);
+        break;
+      case OpCode::NOT_EQUAL:
+        value = equal(a, b);
+        value = {1.0 - value.hi, 1.0 - value.lo};
+        break;
+      case OpCode::POW:
+        value = power(a, b);
+        break;
+      case OpCode::NEG:
+        value = negate(a);
+        break;
+      case OpCode::NOT:
+        value = {1.0 - a.hi, 1.0 - a.lo};
+        break;
+      case OpCode::ABS:
+        value = absolute(a);
+        break;
+      case OpCode::SQRT:
+        value = increasing(a, 0.0, [](double v) { return std::sqrt(v); });
+        break;
+      case OpCode::SIN:
+        value = sine(a, 0.0);
+        break;
+      case OpCode::COS:
+        value = sine(a, pi * 0.5);
+        break;
+      case OpCode::TAN:
+        value = tangent(a, false);
+        break;
+      case OpCode::COT:
+        value = tangent(a, true);
+        break;
+      case OpCode::EXP:
+        value = increasing(a, -infinity, [](double v) { return std::exp(v); });
+        break;
+      case OpCode::LOG:
+        value = increasing(a, 0.0, [](double v) { return std::log(v); });
+        break;
+      default:
+        value = whole(true);
+        break;
+    }
+
+    stack.back() = value;
+  }
+
+  return stack.empty() ? whole(true) : stack.back();
+}
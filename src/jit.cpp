@@ -0,0 +1,478 @@
+#include <SGC/jit.hpp>
+#include <SGC/vmath.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SGC_JIT_X86_64
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+#endif
+
+namespace {
+
+// Frame layout in 8-float slots, shared by the kernel and its caller.
+constexpr std::size_t xSlot = 0;
+constexpr std::size_t ySlot = 1;
+constexpr std::size_t psSlot = 2;
+constexpr std::size_t tSlot = 3;
+constexpr std::size_t outSlot = 4;
+constexpr std::size_t spillSlot = 5;
+constexpr std::size_t registerCount = 14;
+constexpr std::size_t calleeSavedSlot = spillSlot + registerCount;
+constexpr std::size_t frameSlots = calleeSavedSlot + 5;
+
+// Compiled expressions kept for reuse, entries nothing else holds are evicted
+// first.
+constexpr std::size_t maxCachedExpressions = 64;
+
+#ifdef SGC_JIT_X86_64
+// AVX2 in the CPU and YMM state saved by the OS.
+bool isAvx2Supported() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) return false;
+
+  __cpuid(info, 1);
+  const bool isOsxsave = (info[2] & (1 << 27)) != 0;
+  const bool isAvx = (info[2] & (1 << 28)) != 0;
+  if (!isOsxsave || !isAvx || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__)
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+#endif
+
+void jitSin(float* a) { vmath::sin(a, CompiledExpression::laneCount); }
+
+void jitCos(float* a) { vmath::cos(a, CompiledExpression::laneCount); }
+
+void jitTan(float* a) { vmath::tan(a, CompiledExpression::laneCount); }
+
+void jitCot(float* a) { vmath::cot(a, CompiledExpression::laneCount); }
+
+void jitExp(float* a) { vmath::exp(a, CompiledExpression::laneCount); }
+
+void jitLog(float* a) { vmath::log(a, CompiledExpression::laneCount); }
+
+void jitPow(float* a, const float* b) {
+  vmath::pow(a, b, CompiledExpression::laneCount);
+}
+
+#ifdef SGC_JIT_X86_64
+
+enum : std::uint8_t {
+  MAP_0F = 1,
+  MAP_0F38 = 2,
+};
+
+enum : std::uint8_t {
+  PP_NONE = 0,
+  PP_66 = 1,
+};
+
+enum : std::uint8_t {
+  CMP_EQ_OQ = 0x00,
+  CMP_NEQ_UQ = 0x04,
+  CMP_LT_OQ = 0x11,
+  CMP_LE_OQ = 0x12,
+  CMP_GE_OQ = 0x1D,
+  CMP_GT_OQ = 0x1E,
+};
+
+constexpr int tempRegister = 15;
+
+class Assembler {
+ public:
+  std::vector<std::uint8_t> code;
+  std::vector<std::uint32_t> constants;
+
+  std::size_t constant(float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return constantBits(bits);
+  }
+
+  std::size_t constantBits(std::uint32_t bits) {
+    auto it = std::find(constants.begin(), constants.end(), bits);
+    if (it == constants.end()) it = constants.insert(constants.end(), bits);
+    return static_cast<std::size_t>(it - constants.begin());
+  }
+
+  std::size_t codeOffset() const {
+    return (constants.size() * sizeof(std::uint32_t) + 31) & ~std::size_t(31);
+  }
+
+  void bytes(std::initializer_list<std::uint8_t> values) {
+    code.insert(code.end(), values);
+  }
+
+  void u32(std::uint32_t value) {
+    for (int i = 0; i < 4; i++)
+      code.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+
+  void u64(std::uint64_t value) {
+    for (int i = 0; i < 8; i++)
+      code.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+
+  void vex(std::uint8_t map, std::uint8_t pp, bool is256, int reg, int vvvv,
+           int rm) {
+    code.push_back(0xC4);
+    code.push_back(static_cast<std::uint8_t>(
+        (reg >= 8 ? 0x00 : 0x80) | 0x40 | (rm >= 8 ? 0x00 : 0x20) | map));
+    code.push_back(static_cast<std::uint8_t>(((~vvvv & 0xF) << 3) |
+                                             (is256 ? 0x04 : 0x00) | pp));
+  }
+
+  // op reg, vvvv, rm
+  void rr(std::uint8_t opcode, int reg, int vvvv, int rm) {
+    vex(MAP_0F, PP_NONE, true, reg, vvvv, rm);
+    bytes({opcode, static_cast<std::uint8_t>(0xC0 | ((reg & 7) << 3) |
+                                             (rm & 7))});
+  }
+
+  // op reg, vvvv, [rbx + slot]
+  void rm(std::uint8_t opcode, int reg, int vvvv, std::size_t slot,
+          bool is256 = true, std::size_t offset = 0) {
+    vex(MAP_0F, PP_NONE, is256, reg, vvvv, 0);
+    bytes({opcode, static_cast<std::uint8_t>(0x80 | ((reg & 7) << 3) | 3)});
+    u32(static_cast<std::uint32_t>(slot * 32 + offset));
+  }
+
+  void load(int reg, std::size_t slot) { rm(0x10, reg, 0, slot); }
+
+  void store(int reg, std::size_t slot) { rm(0x11, reg, 0, slot); }
+
+  void broadcast(int reg, std::size_t constantIndex) {
+    vex(MAP_0F38, PP_66, true, reg, 0, 0);
+    bytes({0x18, static_cast<std::uint8_t>(((reg & 7) << 3) | 5)});
+    std::size_t end = codeOffset() + code.size() + 4;
+    u32(static_cast<std::uint32_t>(
+        static_cast<std::int64_t>(constantIndex * sizeof(std::uint32_t)) -
+        static_cast<std::int64_t>(end)));
+  }
+
+  void compare(int reg, int rm, std::uint8_t predicate) {
+    rr(0xC2, reg, reg, rm);
+    code.push_back(predicate);
+  }
+
+  void leaArgument(int argument, std::size_t slot) {
+#ifdef _WIN32
+    static const std::uint8_t modrm[] = {0x8B, 0x93};  // rcx, rdx
+#else
+    static const std::uint8_t modrm[] = {0xBB, 0xB3};  // rdi, rsi
+#endif
+    bytes({0x48, 0x8D, modrm[argument]});
+    u32(static_cast<std::uint32_t>(slot * 32));
+  }
+
+  void call(const void* function) {
+    bytes({0xC5, 0xF8, 0x77});  // vzeroupper
+    bytes({0x48, 0xB8});        // mov rax, imm64
+    u64(reinterpret_cast<std::uint64_t>(function));
+    bytes({0xFF, 0xD0});  // call rax
+  }
+};
+
+bool compileKernel(const Expression& expression, Assembler& as) {
+  if (expression.getMaxStackDepth() > registerCount) return false;
+
+  const std::size_t one = as.constant(1.0f);
+  const std::size_t half = as.constant(0.5f);
+  const std::size_t signMask = as.constantBits(0x80000000u);
+  const std::size_t absMask = as.constantBits(0x7FFFFFFFu);
+
+  for (const auto& instruction : expression.getInstructions())
+    if (instruction.op == OpCode::PUSH_CONST) as.constant(instruction.value);
+
+  // Prologue: push rbx; sub rsp, 32; mov rbx, <first argument>
+  as.bytes({0x53, 0x48, 0x83, 0xEC, 0x20});
+#ifdef _WIN32
+  as.bytes({0x48, 0x89, 0xCB});
+  for (int i = 0; i < 10; i++)
+    as.rm(0x11, 6 + i, 0, calleeSavedSlot, false, std::size_t(i) * 16);
+#else
+  as.bytes({0x48, 0x89, 0xFB});
+#endif
+
+  auto callFunction = [&](const void* function, int depth, int arguments) {
+    for (int i = 0; i < depth; i++)
+      as.store(i, spillSlot + static_cast<std::size_t>(i));
+    for (int i = 0; i < arguments; i++)
+      as.leaArgument(
+          i, spillSlot + static_cast<std::size_t>(depth - arguments + i));
+    as.call(function);
+    for (int i = 0; i < depth - arguments + 1; i++)
+      as.load(i, spillSlot + static_cast<std::size_t>(i));
+  };
+
+  int depth = 0;
+
+  for (const auto& instruction : expression.getInstructions()) {
+    const int a = depth - 1;
+    const int l = depth - 2;
+    const int r = depth - 1;
+
+    switch (instruction.op) {
+      case OpCode::PUSH_X:
+        as.load(depth++, xSlot);
+        break;
+      case OpCode::PUSH_Y:
+        as.load(depth++, ySlot);
+        break;
+      case OpCode::PUSH_PS:
+        as.load(depth++, psSlot);
+        break;
+      case OpCode::PUSH_T:
+        as.load(depth++, tSlot);
+        break;
+      case OpCode::PUSH_CONST:
+        as.broadcast(depth++, as.constant(instruction.value));
+        break;
+      case OpCode::ADD:
+        as.rr(0x58, l, l, r), depth--;
+        break;
+      case OpCode::SUB:
+        as.rr(0x5C, l, l, r), depth--;
+        break;
+      case OpCode::MUL:
+      case OpCode::AND:
+        as.rr(0x59, l, l, r), depth--;
+        break;
+      case OpCode::DIV:
+        as.rr(0x5E, l, l, r), depth--;
+        break;
+      case OpCode::OR:
+        as.rr(0x5F, l, l, r), depth--;
+        break;
+      case OpCode::LESS:
+      case OpCode::LESS_EQUAL:
+      case OpCode::GREATER:
+      case OpCode::GREATER_EQUAL:
+      case OpCode::EQUAL:
+      case OpCode::NOT_EQUAL: {
+        std::uint8_t predicate = CMP_EQ_OQ;
+        if (instruction.op == OpCode::LESS) predicate = CMP_LT_OQ;
+        if (instruction.op == OpCode::LESS_EQUAL) predicate = CMP_LE_OQ;
+        if (instruction.op == OpCode::GREATER) predicate = CMP_GT_OQ;
+        if (instruction.op == OpCode::GREATER_EQUAL) predicate = CMP_GE_OQ;
+        if (instruction.op == OpCode::NOT_EQUAL) predicate = CMP_NEQ_UQ;
+        as.compare(l, r, predicate);
+        as.broadcast(tempRegister, one);
+        as.rr(0x54, l, l, tempRegister);
+        depth--;
+        break;
+      }
+      case OpCode::NEG:
+        as.broadcast(tempRegister, signMask);
+        as.rr(0x57, a, a, tempRegister);
+        break;
+      case OpCode::NOT:
+        as.broadcast(tempRegister, one);
+        as.rr(0x5C, a, tempRegister, a);
+        break;
+      case OpCode::ABS:
+        as.broadcast(tempRegister, absMask);
+        as.rr(0x54, a, a, tempRegister);
+        break;
+      case OpCode::SQRT:
+        as.rr(0x51, a, 0, a);
+        break;
+      case OpCode::SIN:
+        callFunction(reinterpret_cast<const void*>(&jitSin), depth, 1);
+        break;
+      case OpCode::COS:
+        callFunction(reinterpret_cast<const void*>(&jitCos), depth, 1);
+        break;
+      case OpCode::TAN:
+        callFunction(reinterpret_cast<const void*>(&jitTan), depth, 1);
+        break;
+      case OpCode::COT:
+        callFunction(reinterpret_cast<const void*>(&jitCot), depth, 1);
+        break;
+      case OpCode::EXP:
+        callFunction(reinterpret_cast<const void*>(&jitExp), depth, 1);
+        break;
+      case OpCode::LOG:
+        callFunction(reinterpret_cast<const void*>(&jitLog), depth, 1);
+        break;
+      case OpCode::POW:
+        callFunction(reinterpret_cast<const void*>(&jitPow), depth, 2);
+        depth--;
+        break;
+      case OpCode::IS_EQUAL_APPROX: {
+        const int first = depth - 3;
+        const int second = depth - 2;
+        const int third = depth - 1;
+        as.rr(0x5C, first, first, second);
+        as.broadcast(tempRegister, absMask);
+        as.rr(0x54, first, first, tempRegister);
+        as.broadcast(tempRegister, half);
+        as.rr(0x59, third, third, tempRegister);
+        as.compare(first, third, CMP_LE_OQ);
+        as.broadcast(tempRegister, one);
+        as.rr(0x54, first, first, tempRegister);
+        depth -= 2;
+        break;
+      }
+    }
+  }
+
+  // Epilogue: store result, restore, vzeroupper; add rsp, 32; pop rbx; ret
+  as.store(0, outSlot);
+#ifdef _WIN32
+  for (int i = 0; i < 10; i++)
+    as.rm(0x10, 6 + i, 0, calleeSavedSlot, false, std::size_t(i) * 16);
+#endif
+  as.bytes({0xC5, 0xF8, 0x77, 0x48, 0x83, 0xC4, 0x20, 0x5B, 0xC3});
+
+  return true;
+}
+
+#endif
+
+}  // namespace
+
+CompiledExpression::CompiledExpression(Expression source)
+    : expression(std::move(source)) {
+  compile();
+}
+
+CompiledExpression::~CompiledExpression() {
+  if (!code) return;
+#if defined(SGC_JIT_X86_64) && defined(_WIN32)
+  VirtualFree(code, 0, MEM_RELEASE);
+#elif defined(SGC_JIT_X86_64)
+  munmap(code, codeSize);
+#endif
+}
+
+const Expression& CompiledExpression::getExpression() const {
+  return expression;
+}
+
+bool CompiledExpression::isNative() const { return kernel != nullptr; }
+
+bool CompiledExpression::compile() {
+#ifdef SGC_JIT_X86_64
+  static const bool isSupported = isAvx2Supported();
+  if (!isSupported) return false;
+
+  Assembler as;
+  if (!compileKernel(expression, as)) return false;
+
+  const std::size_t offset = as.codeOffset();
+  codeSize = offset + as.code.size();
+
+#ifdef _WIN32
+  code = VirtualAlloc(nullptr, codeSize, MEM_COMMIT | MEM_RESERVE,
+                      PAGE_READWRITE);
+  if (!code) return false;
+#else
+  code = mmap(nullptr, codeSize, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (code == MAP_FAILED) {
+    code = nullptr;
+    return false;
+  }
+#endif
+
+  auto* bytes = static_cast<std::uint8_t*>(code);
+  std::memset(bytes, 0xCC, offset);
+  std::memcpy(bytes, as.constants.data(),
+              as.constants.size() * sizeof(std::uint32_t));
+  std::memcpy(bytes + offset, as.code.data(), as.code.size());
+
+#ifdef _WIN32
+  DWORD oldProtection;
+  if (!VirtualProtect(code, codeSize, PAGE_EXECUTE_READ, &oldProtection))
+    return false;
+#else
+  if (mprotect(code, codeSize, PROT_READ | PROT_EXEC) != 0) return false;
+#endif
+
+  kernel = reinterpret_cast<Kernel>(bytes + offset);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CompiledExpression::evaluate(const EvaluationInput& input,
+                                  float* out) const {
+  if (!kernel) {
+    expression.evaluate(input, out);
+    return;
+  }
+
+  alignas(32) float frame[frameSlots * laneCount];
+  std::fill_n(frame + psSlot * laneCount, laneCount, input.ps);
+  std::fill_n(frame + tSlot * laneCount, laneCount, input.t);
+
+  for (std::size_t offset = 0; offset < input.count; offset += laneCount) {
+    const std::size_t count = std::min(laneCount, input.count - offset);
+
+    for (std::size_t i = 0; i < laneCount; i++) {
+      const std::size_t lane = offset + std::min(i, count - 1);
+      frame[xSlot * laneCount + i] = input.x[lane];
+      frame[ySlot * laneCount + i] = input.y[lane];
+    }
+
+    kernel(frame);
+
+    std::copy_n(frame + outSlot * laneCount, count, out + offset);
+  }
+}
+
+std::shared_ptr<const CompiledExpression> compileExpression(
+    const std::string& source) {
+  static std::mutex cacheMutex;
+  static std::unordered_map<std::size_t,
+                            std::shared_ptr<const CompiledExpression>>
+      cache;
+
+  Expression expression(source);
+  const std::size_t hash = expression.hash();
+
+  std::lock_guard lock(cacheMutex);
+
+  auto it = cache.find(hash);
+  if (it != cache.end() && it->second->getExpression().getInstructions() ==
+                               expression.getInstructions())
+    return it->second;
+
+  auto compiled = std::make_shared<const CompiledExpression>(std::move(expression));
+  if (it != cache.end()) return compiled;
+
+  if (cache.size() >= maxCachedExpressions) {
+    std::erase_if(cache, [](const auto& entry) {
+      return entry.second.use_count() == 1;
+    });
+    if (cache.size() >= maxCachedExpressions) cache.erase(cache.begin());
+  }
+
+  cache.emplace(hash, compiled);
+  return compiled;
+}
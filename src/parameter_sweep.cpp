@@ -0,0 +1,103 @@
+#include <SGC/graph_shader.hpp>
+#include <SGC/parameter_sweep.hpp>
+#include <algorithm>
+
+namespace {
+
+// Rectangle and value of a.
+constexpr int instanceFloats = 5;
+
+}  // namespace
+
+ParameterSweep::~ParameterSweep() { release(); }
+
+std::vector<View> ParameterSweep::makeCells(const View& view) const {
+  const int columnCount = std::clamp(columns, 1, maxCellsPerAxis);
+  const int rowCount = std::clamp(rows, 1, maxCellsPerAxis);
+  const int cellCount = columnCount * rowCount;
+
+  const int cellWidth = std::max(view.width / columnCount, 2);
+  const int cellHeight = std::max(view.height / rowCount, 2);
+
+  // One pixel between cells is left uncovered as a border.
+  View cell = view;
+  cell.width = cellWidth - 1;
+  cell.height = cellHeight - 1;
+  cell.zoom =
+      view.zoom *
+      std::min(static_cast<float>(cell.width) / static_cast<float>(view.width),
+               static_cast<float>(cell.height) /
+                   static_cast<float>(view.height));
+  setGridPeriods(cell, static_cast<float>(std::max(cell.width, cell.height)));
+
+  std::vector<View> cells;
+
+  for (int i = 0; i < cellCount; i++) {
+    cell.originX = view.originX + (i % columnCount) * cellWidth;
+    cell.originY =
+        view.originY + view.height - (i / columnCount + 1) * cellHeight;
+    cell.parameter =
+        cellCount > 1 ? from + (to - from) * static_cast<float>(i) /
+                                   static_cast<float>(cellCount - 1)
+                      : from;
+    cells.push_back(cell);
+  }
+
+  return cells;
+}
+
+void ParameterSweep::bindCells(const std::vector<View>& cells) {
+  GLint viewport[4];
+  glGetIntegerv(GL_VIEWPORT, viewport);
+
+  auto toDevice = [&](int pixel, int axis) {
+    return 2.0f * static_cast<GLfloat>(pixel - viewport[axis]) /
+               static_cast<GLfloat>(viewport[axis + 2]) -
+           1.0f;
+  };
+
+  std::vector<GLfloat> newInstances;
+
+  for (const auto& cell : cells)
+    newInstances.insert(newInstances.end(),
+                        {toDevice(cell.originX, 0), toDevice(cell.originY, 1),
+                         toDevice(cell.originX + cell.width, 0),
+                         toDevice(cell.originY + cell.height, 1),
+                         cell.parameter});
+
+  if (instanceBuffer == 0) glGenBuffers(1, &instanceBuffer);
+
+  glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+
+  // The cells only change with the window or the sweep settings.
+  if (newInstances != instances) {
+    instances = std::move(newInstances);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(instances.size() * sizeof(GLfloat)),
+                 instances.data(), GL_DYNAMIC_DRAW);
+  }
+
+  const GLsizei stride = instanceFloats * sizeof(GLfloat);
+
+  glVertexAttribPointer(cellRectAttribute, 4, GL_FLOAT, GL_FALSE, stride,
+                        nullptr);
+  glVertexAttribPointer(cellParameterAttribute, 1, GL_FLOAT, GL_FALSE, stride,
+                        reinterpret_cast<const void*>(4 * sizeof(GLfloat)));
+  glVertexAttribDivisor(cellRectAttribute, 1);
+  glVertexAttribDivisor(cellParameterAttribute, 1);
+  glEnableVertexAttribArray(cellRectAttribute);
+  glEnableVertexAttribArray(cellParameterAttribute);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ParameterSweep::unbindCells() {
+  glDisableVertexAttribArray(cellRectAttribute);
+  glDisableVertexAttribArray(cellParameterAttribute);
+}
+
+void ParameterSweep::release() {
+  if (instanceBuffer != 0) glDeleteBuffers(1, &instanceBuffer);
+  instanceBuffer = 0;
+  instances.clear();
+}
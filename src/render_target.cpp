@@ -0,0 +1,46 @@
+#include <SGC/render_target.hpp>
+
+RenderTarget::~RenderTarget() { release(); }
+
+bool RenderTarget::resize(int newWidth, int newHeight, GLenum newFormat) {
+  if (texture != 0 && width == newWidth && height == newHeight &&
+      internalFormat == newFormat)
+    return false;
+
+  release();
+
+  glGenTextures(1, &texture);
+  glBindTexture(GL_TEXTURE_2D, texture);
+  glTexStorage2D(GL_TEXTURE_2D, 1, newFormat, newWidth, newHeight);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  glGenFramebuffers(1, &framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         texture, 0);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  width = newWidth;
+  height = newHeight;
+  internalFormat = newFormat;
+
+  return true;
+}
+
+void RenderTarget::release() {
+  if (framebuffer != 0) glDeleteFramebuffers(1, &framebuffer);
+  if (texture != 0) glDeleteTextures(1, &texture);
+  framebuffer = 0;
+  texture = 0;
+  width = 0;
+  height = 0;
+}
+
+void RenderTarget::bind() const {
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glViewport(0, 0, width, height);
+}
@@ -1,67 +1,111 @@
 #include <stb_image.h>
 
 #include <SGC/error.hpp>
+#include <SGC/graph_shader.hpp>
 #include <SGC/imgui.hpp>
 #include <SGC/mINI.hpp>
 #include <SGC/opengl.hpp>
+#include <SGC/render_target.hpp>
 #include <SGC/sgc_engine.hpp>
+#include <SGC/shader.hpp>
+#include <SGC/tile_cache.hpp>
 #include <SGC/utils.hpp>
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
 
-const GLchar* vertexShaderSource =                   //
-    "#version 430 core\n"                            //
-    "layout (location = 0) in vec2 attribPos;"       //
-    "out vec2 fragPos;"                              //
-    "void main() {"                                  //
-    "  gl_Position = vec4(attribPos.xy, 0.0, 1.0);"  //
-    "  fragPos = attribPos;"                         //
+const GLchar* textureVertexShaderSource =                          //
+    "#version 430 core\n"                                          //
+    "layout (location = 0) in vec2 attribPos;"                     //
+    "out vec2 uv;"                                                 //
+    "uniform vec4 destRect;"                                       //
+    "uniform vec4 sourceRect;"                                     //
+    "void main() {"                                                //
+    "  vec2 factor = attribPos * 0.5 + 0.5;"                       //
+    "  gl_Position = vec4(mix(destRect.xy, destRect.zw, factor),"  //
+    "    0.0, 1.0);"                                               //
+    "  uv = mix(sourceRect.xy, sourceRect.zw, factor);"            //
     "}";
 
-const std::string fragmentShaderSourceStart =                               //
-    "#version 430 core\n"                                                   //
-    "#define pi 3.1415927410125732\n"                                       //
-    "in vec2 fragPos;"                                                      //
-    "out vec4 FragColor;"                                                   //
-    "uniform vec2 windowSize;"                                              //
-    "uniform vec2 position;"                                                //
-    "uniform float zoom;"                                                   //
-    "uniform float sublinePeriod;"                                          //
-    "uniform float microlinePeriod;"                                        //
-    "uniform float t;"                                                      //
-    "bool isEqualApprox(float a, float b, float c) {"                       //
-    "  return abs(a - b) <= c * 0.5;"                                       //
-    "}"                                                                     //
-    "void main() {"                                                         //
-    "  float pixelSize = 1.0 / zoom;"                                       //
-    "  vec2 worldPos = (windowSize * 0.5 * fragPos)"                        //
-    "    * pixelSize + position;"                                           //
-    "  vec2 pixelSublinePeriod ="                                           //
-    "    (worldPos / sublinePeriod - round(worldPos / sublinePeriod))"      //
-    "    * sublinePeriod;"                                                  //
-    "  vec2 pixelMicrolinePeriod ="                                         //
-    "    (worldPos / microlinePeriod - round(worldPos / microlinePeriod))"  //
-    "    * microlinePeriod;"                                                //
-    "  float x = worldPos.x;"                                               //
-    "  float y = worldPos.y;"                                               //
-    "  float ps = pixelSize;";
-
-const std::string fragmentShaderSourceEnd =                                //
-    "  if (isEqualApprox(worldPos.x, 0.0, pixelSize) ||"                   //
-    "    isEqualApprox(worldPos.y, 0.0, pixelSize))"                       //
-    "    FragColor = vec4(0.0, 0.0, 0.0, 1.0);"                            //
-    "  else if (isEqualApprox(pixelSublinePeriod.x, 0.0, pixelSize) ||"    //
-    "    isEqualApprox(pixelSublinePeriod.y, 0.0, pixelSize))"             //
-    "    FragColor = vec4(0.65, 0.65, 0.65, 1.0);"                         //
-    "  else if (isEqualApprox(pixelMicrolinePeriod.x, 0.0, pixelSize) ||"  //
-    "    isEqualApprox(pixelMicrolinePeriod.y, 0.0, pixelSize))"           //
-    "    FragColor = vec4(0.85, 0.85, 0.85, 1.0);"                         //
-    "  else"                                                               //
-    "    FragColor = vec4(1.0, 1.0, 1.0, 1.0);"                            //
+const GLchar* textureFragmentShaderSource =  //
+    "#version 430 core\n"                    //
+    "in vec2 uv;"                            //
+    "out vec4 FragColor;"                    //
+    "uniform sampler2D image;"               //
+    "void main() {"                          //
+    "  FragColor = texture(image, uv);"      //
     "}";
 
+const GLchar* resolveFragmentShaderSource =                   //
+    "#version 430 core\n"                                     //
+    "out vec4 FragColor;"                                     //
+    "uniform sampler2D image;"                                //
+    "uniform int sampleStep;"                                 //
+    "void main() {"                                           //
+    "  ivec2 pixel = ivec2(gl_FragCoord.xy);"                 //
+    "  ivec2 samplePixel = pixel / sampleStep * sampleStep;"  //
+    "  FragColor = texelFetch(image, samplePixel, 0);"        //
+    "}";
+
+namespace {
+
+// Numbers separated by commas or spaces, anything else ends the list.
+std::vector<float> parseNumbers(const std::string& text) {
+  std::vector<float> numbers;
+  const char* begin = text.c_str();
+
+  while (true) {
+    while (*begin == ',' || *begin == ' ') begin++;
+
+    char* end = nullptr;
+    const float value = std::strtof(begin, &end);
+    if (end == begin) break;
+
+    numbers.push_back(value);
+    begin = end;
+  }
+
+  return numbers;
+}
+
+std::string formatNumbers(const std::vector<float>& numbers) {
+  std::string text;
+
+  for (float value : numbers) {
+    char number[32];
+    std::snprintf(number, sizeof(number), "%g", value);
+    text += (text.empty() ? "" : ", ") + std::string(number);
+  }
+
+  return text;
+}
+
+// Rectangle of the view relative to the viewport in normalized device
+// coordinates, and its camera.
+ViewUniforms makeViewUniforms(const View& view, const GLint viewport[4]) {
+  auto toDevice = [&](int pixel, int axis) {
+    return 2.0f * static_cast<GLfloat>(pixel - viewport[axis]) /
+               static_cast<GLfloat>(viewport[axis + 2]) -
+           1.0f;
+  };
+
+  return {
+      {toDevice(view.originX, 0), toDevice(view.originY, 1),
+       toDevice(view.originX + view.width, 0),
+       toDevice(view.originY + view.height, 1)},
+      {static_cast<GLfloat>(view.width), static_cast<GLfloat>(view.height)},
+      {view.positionX, view.positionY},
+      {view.jitterX, view.jitterY},
+      view.zoom,
+      view.t,
+      view.parameter,
+      {},
+  };
+}
+
 SGCEngine* activeEngine = nullptr;
 
 void glfwWindowSizeCallback(GLFWwindow*, int width, int height) {
@@ -76,6 +120,24 @@ void glfwKeyCallback(GLFWwindow*, int key, int scancode, int action, int mods) {
   activeEngine->keyCallback(key, scancode, action, mods);
 }
 
+void glfwCursorPosCallback(GLFWwindow*, double, double) {
+  activeEngine->requestRedraw();
+}
+
+void glfwMouseButtonCallback(GLFWwindow*, int, int, int) {
+  activeEngine->requestRedraw();
+}
+
+void glfwCharCallback(GLFWwindow*, unsigned int) {
+  activeEngine->requestRedraw();
+}
+
+void glfwWindowRefreshCallback(GLFWwindow*) {
+  if (activeEngine) activeEngine->requestRedraw();
+}
+
+}  // namespace
+
 SGCEngine::SGCEngine() {
   activeEngine = this;
 
@@ -127,6 +189,10 @@ SGCEngine::SGCEngine() {
   glfwSetFramebufferSizeCallback(window, glfwWindowSizeCallback);
   glfwSetScrollCallback(window, glfwScrollCallback);
   glfwSetKeyCallback(window, glfwKeyCallback);
+  glfwSetCursorPosCallback(window, glfwCursorPosCallback);
+  glfwSetMouseButtonCallback(window, glfwMouseButtonCallback);
+  glfwSetCharCallback(window, glfwCharCallback);
+  glfwSetWindowRefreshCallback(window, glfwWindowRefreshCallback);
 
   glfwMakeContextCurrent(window);
 
@@ -138,6 +204,8 @@ SGCEngine::SGCEngine() {
                    "[GLAD]: Failed to load OpenGL loader.\n");
 
   // OpenGL Setup
+  glfwSwapInterval(swapInterval);
+
   glViewport(0, 0, 800, 800);
 
   glEnable(GL_CULL_FACE);
@@ -190,6 +258,28 @@ SGCEngine::SGCEngine() {
     throw SGCError(SGCErrorType::OPENGL_ERROR,
                    "[OpenGL]: Failed to compile shader program.\n");
 
+  textureProgram =
+      makeProgram(textureVertexShaderSource, textureFragmentShaderSource);
+
+  if (textureProgram == 0)
+    throw SGCError(SGCErrorType::OPENGL_ERROR,
+                   "[OpenGL]: Failed to compile texture program.\n");
+
+  textureDestRectUniformLocation =
+      glGetUniformLocation(textureProgram, "destRect");
+  textureSourceRectUniformLocation =
+      glGetUniformLocation(textureProgram, "sourceRect");
+
+  resolveProgram =
+      makeProgram(textureVertexShaderSource, resolveFragmentShaderSource);
+
+  if (resolveProgram == 0)
+    throw SGCError(SGCErrorType::OPENGL_ERROR,
+                   "[OpenGL]: Failed to compile resolve program.\n");
+
+  resolveSampleStepUniformLocation =
+      glGetUniformLocation(resolveProgram, "sampleStep");
+
   // ImGui Setup
   IMGUI_CHECKVERSION();
   ImGui::CreateContext();
@@ -209,9 +299,37 @@ SGCEngine::~SGCEngine() {
 
   ImGui::DestroyContext();
 
+  graphLayers[0].release();
+  graphLayers[1].release();
+  tileCache.clear();
+  progressiveTarget.release();
+  scaledTarget.release();
+  grid.release();
+  curveRenderer.release();
+  columnRenderer.release();
+  graphPasses.release();
+  edgeSupersampler.release();
+  heatmapRenderer.release();
+  contourRenderer.release();
+  vectorFieldRenderer.release();
+  trajectoryRenderer.release();
+  supersampledTarget.release();
+  accumulationTarget.release();
+  minimapTarget.release();
+  jitteredTarget.release();
+  framePacer.release();
+  uniformRing.release();
+  parameterSweep.release();
+
+  if (timerQueries[0] != 0) glDeleteQueries(3, timerQueries);
+
   glfwSetFramebufferSizeCallback(window, nullptr);
   glfwSetScrollCallback(window, nullptr);
   glfwSetKeyCallback(window, nullptr);
+  glfwSetCursorPosCallback(window, nullptr);
+  glfwSetMouseButtonCallback(window, nullptr);
+  glfwSetCharCallback(window, nullptr);
+  glfwSetWindowRefreshCallback(window, nullptr);
 
   glfwTerminate();
 
@@ -219,103 +337,225 @@ SGCEngine::~SGCEngine() {
 }
 
 bool SGCEngine::makeShaderProgram() {
-  GLint shaderSetupSuccess;
-  static GLchar shaderSetupInfoLog[GL_INFO_LOG_LENGTH];
+  graphsRevision++;
 
-  GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+  std::string fragmentShaderSourceStr = isCoverageShading
+                                            ? coverageFragmentShaderSourceStart
+                                            : fragmentShaderSourceStart;
 
-  glShaderSource(vertexShader, 1, &vertexShaderSource, nullptr);
-  glCompileShader(vertexShader);
+  // Graphs drawn outside the fused program only go into the hash.
+  std::string separateParts;
+  std::vector<Graph> pixelGraphs;
 
-  glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &shaderSetupSuccess);
+  auto getShaderPart = [this](const Graph& graph) {
+    return isCoverageShading ? graph.getCoverageShaderPart()
+                             : graph.getGraphShaderPart();
+  };
 
-  if (!shaderSetupSuccess) {
-    glGetShaderInfoLog(vertexShader, GL_INFO_LOG_LENGTH, nullptr, shaderSetupInfoLog);
-    return false;
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible) continue;
+
+    if (graph.type == GraphType::HEATMAP)
+      separateParts += graph.body + std::to_string(
+                                        static_cast<int>(graph.colormap));
+    else if (graph.type == GraphType::CONTOUR ||
+             graph.type == GraphType::VECTOR_FIELD ||
+             graph.type == GraphType::ODE)
+      separateParts += graph.body;
+    else if (functionalGraphMode != FunctionalGraphMode::PIXELS &&
+             graph.isColumnConstant())
+      separateParts += graph.getGraphShaderPart();
+    else
+      pixelGraphs.push_back(graph);
   }
 
-  std::string fragmentShaderSourceStr = fragmentShaderSourceStart;
+  // Per pixel graphs keep the list order. Curves and columns are a layer above
+  // them, so the functional graphs that read y are moved up with them.
+  if (functionalGraphMode != FunctionalGraphMode::PIXELS)
+    std::stable_partition(
+        pixelGraphs.begin(), pixelGraphs.end(),
+        [](const Graph& graph) { return graph.isFunctional; });
 
-  for (const auto& graph : graphs)
-    if (graph.isVisible)
-      fragmentShaderSourceStr += graph.getGraphShaderPart();
+  for (const auto& graph : pixelGraphs)
+    if (isGraphPasses)
+      separateParts += getShaderPart(graph);
+    else
+      fragmentShaderSourceStr += getShaderPart(graph);
 
-  fragmentShaderSourceStr += fragmentShaderSourceEnd;
+  fragmentShaderSourceStr += isCoverageShading
+                                 ? coverageFragmentShaderSourceEnd
+                                 : fragmentShaderSourceEnd;
 
-  const GLchar* fragmentShaderSource = fragmentShaderSourceStr.c_str();
+  graphSourcesHash =
+      std::hash<std::string>{}(fragmentShaderSourceStr + separateParts);
+  graphsHash = graphSourcesHash ^ getGraphStylesHash();
 
-  GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+  const GLuint program =
+      makeProgram(vertexShaderSource.c_str(), fragmentShaderSourceStr.c_str());
 
-  glShaderSource(fragmentShader, 1, &fragmentShaderSource, nullptr);
-  glCompileShader(fragmentShader);
+  if (program == 0) return false;
 
-  glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &shaderSetupSuccess);
+  const std::vector<Graph> noGraphs;
+  const bool areCurvesSet = curveRenderer.setGraphs(
+      functionalGraphMode == FunctionalGraphMode::CURVES ? graphs : noGraphs);
+  const bool areColumnsSet = columnRenderer.setGraphs(
+      functionalGraphMode == FunctionalGraphMode::COLUMNS ? graphs : noGraphs);
 
-  if (!shaderSetupSuccess) {
-    glGetShaderInfoLog(fragmentShader, GL_INFO_LOG_LENGTH, nullptr, shaderSetupInfoLog);
-    glDeleteShader(vertexShader);
+  const bool arePassesSet =
+      graphPasses.setGraphs(isGraphPasses ? pixelGraphs : noGraphs,
+                            isCoverageShading);
+
+  const bool areSupersampledSet = edgeSupersampler.setGraphs(
+      isEdgeSupersampling ? pixelGraphs : noGraphs);
+
+  const bool areHeatmapsSet = heatmapRenderer.setGraphs(graphs);
+  const bool areContoursSet = contourRenderer.setGraphs(graphs);
+  const bool areFieldsSet = vectorFieldRenderer.setGraphs(graphs);
+  const bool areTrajectoriesSet = trajectoryRenderer.setGraphs(graphs);
+
+  if (!areCurvesSet || !areColumnsSet || !arePassesSet ||
+      !areSupersampledSet || !areHeatmapsSet || !areContoursSet ||
+      !areFieldsSet || !areTrajectoriesSet) {
+    glDeleteProgram(program);
     return false;
   }
 
-  GLuint shaderProgram = glCreateProgram();
+  if (shaderProgram != 0) glDeleteProgram(shaderProgram);
 
-  glAttachShader(shaderProgram, vertexShader);
-  glAttachShader(shaderProgram, fragmentShader);
+  shaderProgram = program;
 
-  glLinkProgram(shaderProgram);
+  return true;
+}
 
-  glGetProgramiv(shaderProgram, GL_LINK_STATUS, &shaderSetupSuccess);
+void SGCEngine::updateGraphStyles() {
+  contourRenderer.setStyles(graphs);
+  trajectoryRenderer.setStyles(graphs);
+  graphsHash = graphSourcesHash ^ getGraphStylesHash();
+  graphsRevision++;
+}
 
-  if (!shaderSetupSuccess) {
-    glGetProgramInfoLog(shaderProgram, GL_INFO_LOG_LENGTH, nullptr, shaderSetupInfoLog);
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    return false;
+std::size_t SGCEngine::getGraphStylesHash() const {
+  std::size_t hash = 0;
+
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible || (graph.type != GraphType::CONTOUR &&
+                             graph.type != GraphType::ODE))
+      continue;
+
+    for (float value : graph.levels)
+      hash = hash * 31 + std::hash<float>{}(value);
+    for (float value : graph.seeds)
+      hash = hash * 31 + std::hash<float>{}(value);
+    hash = hash * 31 + static_cast<std::size_t>(graph.odeMethod);
+    for (float value : {graph.r, graph.g, graph.b, graph.thickness})
+      hash = hash * 31 + std::hash<float>{}(value);
   }
 
-  glDeleteShader(vertexShader);
-  glDeleteShader(fragmentShader);
+  return hash;
+}
 
-  if (this->shaderProgram != 0) glDeleteProgram(this->shaderProgram);
+bool SGCEngine::needsContinuousRedraw() const {
+  if (!isOnDemandRendering) return true;
 
-  this->shaderProgram = shaderProgram;
+  if (ImGui::GetIO().WantTextInput) return true;
 
-  windowSizeUniformLocation = glGetUniformLocation(shaderProgram, "windowSize");
-  positionUniformLocation = glGetUniformLocation(shaderProgram, "position");
-  zoomUniformLocation = glGetUniformLocation(shaderProgram, "zoom");
-  sublinePeriodUniformLocation =
-      glGetUniformLocation(shaderProgram, "sublinePeriod");
-  microlinePeriodUniformLocation =
-      glGetUniformLocation(shaderProgram, "microlinePeriod");
-  timeUniformLocation = glGetUniformLocation(shaderProgram, "t");
+  if (!ImGui::GetIO().WantCaptureKeyboard)
+    for (int key : {GLFW_KEY_UP, GLFW_KEY_DOWN, GLFW_KEY_RIGHT, GLFW_KEY_LEFT,
+                    GLFW_KEY_Z})
+      if (glfwGetKey(window, key) == GLFW_PRESS) return true;
 
-  return true;
+  return isAnimated() && animationClock.isPlaying;
+}
+
+bool SGCEngine::isAnimated() const {
+  for (const auto& graph : graphs)
+    if (graph.isVisible && graph.usesTime()) return true;
+
+  return false;
+}
+
+bool SGCEngine::needsRedraw() const {
+  if (redrawFrames > 0 || needsContinuousRedraw()) return true;
+
+  if (lastDrawnGraphsRevision != graphsRevision) return true;
+
+  const View view = makeView();
+
+  return !hasSameScale(view, lastDrawnView) ||
+         !hasSamePosition(view, lastDrawnView);
+}
+
+void SGCEngine::requestRedraw() {
+  // ImGui needs a few frames to settle after input (popups, hover states).
+  redrawFrames = 3;
 }
 
 void SGCEngine::run() {
   while (!glfwWindowShouldClose(window)) {
-    glfwPollEvents();
+    framePacer.beginFrame();
+
+    if (needsRedraw())
+      glfwPollEvents();
+    else
+      glfwWaitEventsTimeout(0.25);
+
+    if (!needsRedraw()) {
+      skippedFrames++;
+      continue;
+    }
+
+    if (redrawFrames > 0) redrawFrames--;
+
+    animationClock.update(glfwGetTime());
 
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
 
-    process();
+    if (!framePacer.isLowLatency) process();
 
     processGUI();
 
+    // Camera input that arrived while the interface was built is latched
+    // right before drawing.
+    if (framePacer.isLowLatency) {
+      glfwPollEvents();
+      process();
+    }
+
+    uniformRing.beginFrame();
     draw();
+    if (isMinimap) drawMinimap(makeView());
+    uniformRing.endFrame();
 
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
     glfwSwapBuffers(window);
+    framePacer.endFrame();
+
+    lastDrawnView = makeView();
+    lastDrawnGraphsRevision = graphsRevision;
+
+    drawnFramesInSecond++;
+    if (glfwGetTime() - frameRateMeasureStart >= 1.0) {
+      drawnFrameRate = static_cast<float>(
+          static_cast<double>(drawnFramesInSecond) /
+          (glfwGetTime() - frameRateMeasureStart));
+      drawnFramesInSecond = 0;
+      frameRateMeasureStart = glfwGetTime();
+    }
   }
 }
 
 void SGCEngine::process() {
   if (ImGui::GetIO().WantCaptureKeyboard) return;
 
+  for (int key : {GLFW_KEY_UP, GLFW_KEY_DOWN, GLFW_KEY_RIGHT, GLFW_KEY_LEFT,
+                  GLFW_KEY_Z})
+    if (glfwGetKey(window, key) == GLFW_PRESS)
+      framePacer.addInput(glfwGetTime());
+
   if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS) positionY += 2.0 / zoom;
   if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) positionY -= 2.0 / zoom;
   if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) positionX += 2.0 / zoom;
@@ -342,6 +582,82 @@ void SGCEngine::processGUI() {
   static float graphColor[3] = {0.5};
   static float graphThickness = 1.0;
   static bool graphIsFunctional = true;
+  static int graphType = 0;
+  static int graphColormap = 0;
+
+  static char graphLevels[1024];
+  static float graphLevelRange[2] = {-1.0f, 1.0f};
+  static int graphLevelCount = 11;
+
+  static char graphSeeds[32768];
+  static int graphOdeMethod = 0;
+  static float graphSeedRangeX[2] = {-2.0f, 2.0f};
+  static float graphSeedRangeY[2] = {-2.0f, 2.0f};
+  static int graphSeedsPerSide = 5;
+
+  static auto showGraphTypeOptions = []() {
+    ImGui::Combo("Type", &graphType,
+                 "Plain\0Heatmap\0Contour\0Vector field\0ODE\0");
+
+    if (graphType == static_cast<int>(GraphType::HEATMAP)) {
+      ImGui::Combo("Colormap", &graphColormap,
+                   "Viridis\0Turbo\0Coolwarm (diverging)\0Grayscale\0");
+    } else if (graphType == static_cast<int>(GraphType::CONTOUR)) {
+      ImGui::InputText("Levels", graphLevels, sizeof(graphLevels));
+      ImGui::SetItemTooltip("Up to %d values separated by commas.",
+                            ContourRenderer::maxLevels);
+      ImGui::DragFloat2("Level range", graphLevelRange, 0.1f);
+      ImGui::SliderInt("Level count", &graphLevelCount, 1,
+                       ContourRenderer::maxLevels);
+
+      if (ImGui::Button("Uniform levels")) {
+        std::vector<float> levels;
+        for (int i = 0; i < graphLevelCount; i++)
+          levels.push_back(
+              graphLevelCount > 1
+                  ? graphLevelRange[0] + (graphLevelRange[1] -
+                                          graphLevelRange[0]) *
+                                             static_cast<float>(i) /
+                                             static_cast<float>(
+                                                 graphLevelCount - 1)
+                  : graphLevelRange[0]);
+        std::snprintf(graphLevels, sizeof(graphLevels), "%s",
+                      formatNumbers(levels).c_str());
+      }
+    } else if (graphType == static_cast<int>(GraphType::VECTOR_FIELD)) {
+      ImGui::TextDisabled("Body is u, v.");
+    } else if (graphType == static_cast<int>(GraphType::ODE)) {
+      ImGui::TextDisabled("Body is dy/dx, or u, v for a system.");
+      ImGui::Combo("Method", &graphOdeMethod, "RK4\0RK45 (adaptive)\0");
+      ImGui::InputText("Seeds", graphSeeds, sizeof(graphSeeds));
+      ImGui::SetItemTooltip("Up to %d x, y pairs separated by commas.",
+                            TrajectoryRenderer::maxSeeds);
+      ImGui::DragFloat2("Seed x range", graphSeedRangeX, 0.1f);
+      ImGui::DragFloat2("Seed y range", graphSeedRangeY, 0.1f);
+      ImGui::SliderInt("Seeds per side", &graphSeedsPerSide, 1, 32);
+
+      if (ImGui::Button("Seed grid")) {
+        auto getCoordinate = [](const float range[2], int i) {
+          return graphSeedsPerSide > 1
+                     ? range[0] + (range[1] - range[0]) *
+                                      static_cast<float>(i) /
+                                      static_cast<float>(graphSeedsPerSide - 1)
+                     : range[0];
+        };
+
+        std::vector<float> seeds;
+        for (int i = 0; i < graphSeedsPerSide; i++)
+          for (int j = 0; j < graphSeedsPerSide; j++) {
+            seeds.push_back(getCoordinate(graphSeedRangeX, i));
+            seeds.push_back(getCoordinate(graphSeedRangeY, j));
+          }
+        std::snprintf(graphSeeds, sizeof(graphSeeds), "%s",
+                      formatNumbers(seeds).c_str());
+      }
+    } else {
+      ImGui::Checkbox("Is functional", &graphIsFunctional);
+    }
+  };
   bool isGraphToRemove = false;
   std::size_t graphToRemoveIndex = 0;
   static char graphsSavefileName[33];
@@ -363,6 +679,11 @@ void SGCEngine::processGUI() {
   if (ImGui::BeginMenu("Windows")) {
     if (ImGui::MenuItem("Info")) isInfoWindowOpen = !isInfoWindowOpen;
     if (ImGui::MenuItem("Graphs")) isGraphsWindowOpen = !isGraphsWindowOpen;
+    ImGui::MenuItem("Minimap", nullptr, &isMinimap);
+    ImGui::SetItemTooltip(
+        "Overview of %.0fx the view, shaded at %d pixels wide and kept until\n"
+        "the graphs change or the view leaves it.",
+        minimapExtent, minimapResolution);
     ImGui::EndMenu();
   }
 
@@ -379,6 +700,173 @@ void SGCEngine::processGUI() {
     ImGui::EndMenu();
   }
 
+  if (ImGui::BeginMenu("Render")) {
+    if (ImGui::MenuItem("Software renderer", nullptr,
+                        renderBackend == RenderBackend::SOFTWARE))
+      renderBackend = renderBackend == RenderBackend::SOFTWARE
+                          ? RenderBackend::OPENGL
+                          : RenderBackend::SOFTWARE;
+
+    ImGui::MenuItem("Render on demand", nullptr, &isOnDemandRendering);
+
+    if (ImGui::BeginMenu("Functional graphs")) {
+      FunctionalGraphMode mode = functionalGraphMode;
+
+      if (ImGui::MenuItem("Per pixel", nullptr,
+                          mode == FunctionalGraphMode::PIXELS))
+        mode = FunctionalGraphMode::PIXELS;
+      ImGui::SetItemTooltip("Test y = f(x) in the fragment shader.");
+
+      if (ImGui::MenuItem("Curves", nullptr,
+                          mode == FunctionalGraphMode::CURVES))
+        mode = FunctionalGraphMode::CURVES;
+      ImGui::SetItemTooltip(
+          "Draw y = f(x) as anti-aliased lines sampled per pixel column.");
+
+      if (ImGui::MenuItem("Columns", nullptr,
+                          mode == FunctionalGraphMode::COLUMNS))
+        mode = FunctionalGraphMode::COLUMNS;
+      ImGui::SetItemTooltip(
+          "Evaluate y = f(x) once per column in a compute shader.");
+
+      if (mode != functionalGraphMode) {
+        functionalGraphMode = mode;
+        makeShaderProgram();
+      }
+
+      ImGui::EndMenu();
+    }
+
+    if (ImGui::MenuItem("Analytic anti-aliasing", nullptr,
+                        &isCoverageShading))
+      makeShaderProgram();
+    ImGui::SetItemTooltip(
+        "Blend per pixel graphs by their distance to the pixel, estimated\n"
+        "from the value and its gradient, instead of a hard inside test.");
+
+    if (ImGui::MenuItem("Separate graph passes", nullptr, &isGraphPasses))
+      makeShaderProgram();
+    ImGui::SetItemTooltip(
+        "Draw every per pixel graph with its own program, clipped to the\n"
+        "area interval analysis finds it can cover.");
+
+    if (ImGui::MenuItem("Edge supersampling", nullptr, &isEdgeSupersampling))
+      makeShaderProgram();
+    ImGui::SetItemTooltip(
+        "Once the view stops, shade per pixel graphs with %d samples on\n"
+        "pixels near an edge and one sample elsewhere.",
+        EdgeSupersampler::samplesPerAxis * EdgeSupersampler::samplesPerAxis);
+
+    ImGui::MenuItem("Temporal accumulation", nullptr, &isTemporalAccumulation);
+    ImGui::SetItemTooltip(
+        "Once the view stops, average %d frames shaded at sub-pixel\n"
+        "offsets, then show the result without shading.",
+        accumulationFrameCount);
+
+    ImGui::MenuItem("Cache graph layer", nullptr, &isGraphLayerCaching);
+    ImGui::SetItemTooltip("Reuse pixels when panning by whole pixels.");
+
+    ImGui::MenuItem("Progressive rendering", nullptr, &isProgressiveRendering);
+    ImGui::SetItemTooltip(
+        "Render at 1/4 resolution while the view changes, then refine.");
+
+    ImGui::MenuItem("Tile cache", nullptr, &isTileCaching);
+    ImGui::SetItemTooltip("Keep rendered tiles of static graphs per zoom level.");
+
+    ImGui::MenuItem("Dynamic resolution", nullptr, &isDynamicResolution);
+    ImGui::SetItemTooltip(
+        "Lower the resolution while the view changes to keep the graph pass\n"
+        "under the target frame time, full resolution when idle.");
+
+    ImGui::DragFloat("Target frame time (ms)", &targetFrameTime, 0.1f, 2.0f,
+                     100.0f, "%.1f");
+
+    ImGui::MenuItem("Low latency", nullptr, &framePacer.isLowLatency);
+    ImGui::SetItemTooltip(
+        "Keep at most one frame queued on the GPU and read camera input\n"
+        "right before drawing.");
+
+    if (ImGui::SliderInt("Swap interval", &swapInterval, 0, 4))
+      glfwSwapInterval(swapInterval);
+    ImGui::SetItemTooltip("Display refreshes per frame, 0 disables vsync.");
+
+    int tileCacheBudget = static_cast<int>(tileCache.budgetMegabytes);
+    if (ImGui::DragInt("Tile cache budget (MB)", &tileCacheBudget, 1.0f, 16,
+                       4096))
+      tileCache.budgetMegabytes = static_cast<std::size_t>(tileCacheBudget);
+
+    ImGui::EndMenu();
+  }
+
+  if (ImGui::BeginMenu("Animation")) {
+    if (ImGui::MenuItem(animationClock.isPlaying ? "Pause" : "Play"))
+      animationClock.isPlaying = !animationClock.isPlaying;
+
+    if (ImGui::MenuItem("Step")) animationClock.step();
+    ImGui::SetItemTooltip("Move t one animation frame forward.");
+
+    if (ImGui::MenuItem("Reset")) animationClock.reset();
+
+    ImGui::DragFloat("Speed", &animationClock.speed, 0.01f, -10.0f, 10.0f,
+                     "%.2fx");
+
+    ImGui::DragFloat("Animation rate (Hz)", &animationClock.stepRate, 0.5f,
+                     0.0f, 240.0f, "%.1f");
+    ImGui::SetItemTooltip(
+        "Advance t at this fixed rate and reuse the last animated frame in\n"
+        "between, 0 advances t every drawn frame.");
+
+    ImGui::EndMenu();
+  }
+
+  if (ImGui::BeginMenu("Parameter")) {
+    ImGui::DragFloat("a", &parameter, 0.01f);
+    ImGui::SetItemTooltip("Value of a in graph bodies outside the sweep.");
+
+    ImGui::MenuItem("Sweep", nullptr, &isParameterSweep);
+    ImGui::SetItemTooltip(
+        "Draw a grid of small plots with a spread over a range, all cells\n"
+        "in one instanced draw of the same programs.");
+
+    ImGui::SliderInt("Columns", &parameterSweep.columns, 1,
+                     ParameterSweep::maxCellsPerAxis);
+    ImGui::SliderInt("Rows", &parameterSweep.rows, 1,
+                     ParameterSweep::maxCellsPerAxis);
+    ImGui::DragFloat("From", &parameterSweep.from, 0.01f);
+    ImGui::DragFloat("To", &parameterSweep.to, 0.01f);
+
+    ImGui::EndMenu();
+  }
+
+  if (ImGui::BeginMenu("Split view")) {
+    ImGui::SliderInt("Views", &splitViewCount, 1, maxFrameViews);
+    ImGui::SetItemTooltip(
+        "Split the window into views with their own cameras. The first view\n"
+        "follows the main camera, all views share the graph programs.");
+
+    for (int i = 1; i < splitViewCount; i++) {
+      SplitCamera& camera = splitCameras[i - 1];
+
+      ImGui::PushID(i);
+      ImGui::SeparatorText(("View " + std::to_string(i + 1)).c_str());
+      ImGui::DragFloat("X", &camera.positionX, 0.01f);
+      ImGui::DragFloat("Y", &camera.positionY, 0.01f);
+      ImGui::DragFloat("Zoom", &camera.zoom, 1.0f, 1.0f, 100000.0f, "%.1f",
+                       ImGuiSliderFlags_Logarithmic);
+      ImGui::DragFloat("t offset", &camera.timeOffset, 0.01f);
+
+      if (ImGui::Button("Copy main camera")) {
+        camera.positionX = positionX;
+        camera.positionY = positionY;
+        camera.zoom = zoom;
+      }
+
+      ImGui::PopID();
+    }
+
+    ImGui::EndMenu();
+  }
+
   ImGui::EndMainMenuBar();
 
   if (isInfoWindowOpen) {
@@ -390,6 +878,8 @@ void SGCEngine::processGUI() {
                  std::to_string(windowHeight) + ")")
                     .c_str());
     ImGui::TextUnformatted(("Zoom: " + std::to_string(zoom)).c_str());
+    ImGui::TextUnformatted(
+        ("t: " + std::to_string(animationClock.getTime())).c_str());
     ImGui::TextUnformatted(("Pos: (" + std::to_string(positionX) + ";" +
                  std::to_string(positionY) + ")")
                     .c_str());
@@ -405,6 +895,60 @@ void SGCEngine::processGUI() {
                     .c_str());
 
     ImGui::TextUnformatted(("FPS: " + std::to_string(ImGui::GetIO().Framerate)).c_str());
+    ImGui::TextUnformatted(
+        ("Drawn FPS: " + std::to_string(drawnFrameRate)).c_str());
+    ImGui::TextUnformatted(
+        ("Skipped frames: " + std::to_string(skippedFrames)).c_str());
+
+    if (isTileCaching) {
+      const std::size_t lookups = tileCache.hits + tileCache.misses;
+      ImGui::TextUnformatted(
+          ("Tiles: " + std::to_string(tileCache.getTileCount()) + " (" +
+           std::to_string(tileCache.getMemoryUsage() / (1024 * 1024)) +
+           " MB), hit rate: " +
+           std::to_string(lookups == 0 ? 0.0
+                                       : 100.0 * static_cast<double>(tileCache.hits) /
+                                             static_cast<double>(lookups)) +
+           "%, misses: " + std::to_string(tileCache.misses))
+              .c_str());
+    }
+
+    if (isGraphPasses)
+      ImGui::TextUnformatted(
+          ("Graph pass area: " +
+           std::to_string(static_cast<int>(
+               std::lround(graphPasses.getCoverage() * 100.0f))) +
+           "% of the screen")
+              .c_str());
+
+    ImGui::TextUnformatted(uniformRing.isPersistent()
+                               ? "Uniforms: persistent mapped ring"
+                               : "Uniforms: buffer updates");
+    ImGui::TextUnformatted(
+        ("Input latency: " + std::to_string(framePacer.getLatency()) + " ms")
+            .c_str());
+
+    if (isTemporalAccumulation)
+      ImGui::TextUnformatted(("Accumulated frames: " +
+                              std::to_string(accumulatedFrames) + "/" +
+                              std::to_string(accumulationFrameCount))
+                                 .c_str());
+
+    if (isDynamicResolution)
+      ImGui::TextUnformatted(
+          ("Resolution scale: " +
+           std::to_string(static_cast<int>(
+               std::lround(drawnResolutionScale * 100.0f))) +
+           "%, graph pass: " + std::to_string(graphPassTime) + " ms")
+              .c_str());
+
+    if (renderBackend == RenderBackend::SOFTWARE && softwareRenderer)
+      ImGui::TextUnformatted(
+          ("Backend: Software (" +
+           std::to_string(softwareRenderer->getThreadCount()) + " threads)")
+              .c_str());
+    else
+      ImGui::Text("Backend: OpenGL");
 
     ImGui::End();
   }
@@ -437,7 +981,27 @@ void SGCEngine::processGUI() {
           ImGui::SetItemTooltip("Graph is not valid.");
         }
 
-        if (graphs.at(i).isFunctional)
+        if (renderBackend == RenderBackend::SOFTWARE && softwareRenderer) {
+          const auto& skippedGraphs = softwareRenderer->getSkippedGraphs();
+          const auto skipped = skippedGraphs.find(graphs.at(i).name);
+
+          if (skipped != skippedGraphs.end()) {
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "!");
+            ImGui::SetItemTooltip("Not drawn by the software backend: %s",
+                                  skipped->second.c_str());
+          }
+        }
+
+        if (graphs.at(i).type == GraphType::HEATMAP)
+          ImGui::Text("Heatmap");
+        else if (graphs.at(i).type == GraphType::CONTOUR)
+          ImGui::Text("Contour");
+        else if (graphs.at(i).type == GraphType::VECTOR_FIELD)
+          ImGui::Text("Vector field");
+        else if (graphs.at(i).type == GraphType::ODE)
+          ImGui::Text("ODE");
+        else if (graphs.at(i).isFunctional)
           ImGui::Text("Functional");
         else
           ImGui::Text("Equational");
@@ -449,7 +1013,8 @@ void SGCEngine::processGUI() {
         else
           ImGui::Text("Invisible");
 
-        if (graphs.at(i).isFunctional)
+        if (graphs.at(i).type == GraphType::PLAIN &&
+            graphs.at(i).isFunctional)
           ImGui::TextUnformatted(("y = " + graphs.at(i).body).c_str());
         else
           ImGui::TextUnformatted((graphs.at(i).body).c_str());
@@ -521,6 +1086,13 @@ void SGCEngine::processGUI() {
     for (std::size_t i = 0; i < 3; i++) graphColor[i] = 0.5;
     graphThickness = 1.0;
     graphIsFunctional = true;
+    graphType = 0;
+    graphColormap = 0;
+    std::snprintf(graphLevels, sizeof(graphLevels), "%s",
+                  formatNumbers({-1.0f, -0.5f, 0.0f, 0.5f, 1.0f}).c_str());
+    std::snprintf(graphSeeds, sizeof(graphSeeds), "%s",
+                  formatNumbers({0.0f, 0.0f}).c_str());
+    graphOdeMethod = 0;
   }
 
   if (ImGui::BeginPopupModal("Add graph", nullptr,
@@ -529,8 +1101,9 @@ void SGCEngine::processGUI() {
     ImGui::InputText("Body", graphBody, sizeof(graphBody));
     ImGui::ColorEdit3("Color", graphColor);
     ImGui::DragFloat("Thickness", &graphThickness, 0.1f, 0.2f, 5.0f);
-    ImGui::SetItemTooltip("Only for functional graphs.");
-    ImGui::Checkbox("Is functional", &graphIsFunctional);
+    ImGui::SetItemTooltip(
+        "For functional, contour, vector field and ODE graphs.");
+    showGraphTypeOptions();
 
     if (ImGui::Button("Add")) {
       std::string name(graphName);
@@ -538,6 +1111,11 @@ void SGCEngine::processGUI() {
         graphs.push_back(Graph(graphIsFunctional, std::move(graphName),
                                std::string(graphBody), graphColor[0],
                                graphColor[1], graphColor[2], graphThickness));
+        graphs.back().type = static_cast<GraphType>(graphType);
+        graphs.back().colormap = static_cast<Colormap>(graphColormap);
+        graphs.back().levels = parseNumbers(graphLevels);
+        graphs.back().seeds = parseNumbers(graphSeeds);
+        graphs.back().odeMethod = static_cast<OdeMethod>(graphOdeMethod);
         ImGui::CloseCurrentPopup();
         graphs.back().isValid = makeShaderProgram();
       } else
@@ -573,6 +1151,13 @@ void SGCEngine::processGUI() {
     graphColor[2] = graphs.at(editGraphIndex).b;
     graphThickness = graphs.at(editGraphIndex).thickness;
     graphIsFunctional = graphs.at(editGraphIndex).isFunctional;
+    graphType = static_cast<int>(graphs.at(editGraphIndex).type);
+    graphColormap = static_cast<int>(graphs.at(editGraphIndex).colormap);
+    std::snprintf(graphLevels, sizeof(graphLevels), "%s",
+                  formatNumbers(graphs.at(editGraphIndex).levels).c_str());
+    std::snprintf(graphSeeds, sizeof(graphSeeds), "%s",
+                  formatNumbers(graphs.at(editGraphIndex).seeds).c_str());
+    graphOdeMethod = static_cast<int>(graphs.at(editGraphIndex).odeMethod);
   }
 
   if (ImGui::BeginPopupModal("Edit graph", nullptr,
@@ -580,18 +1165,38 @@ void SGCEngine::processGUI() {
     ImGui::InputText("Body", graphBody, sizeof(graphBody));
     ImGui::ColorEdit3("Color", graphColor);
     ImGui::DragFloat("Thickness", &graphThickness, 0.1f, 0.2f, 5.0f);
-    ImGui::SetItemTooltip("Only for functional graphs.");
-    ImGui::Checkbox("Is functional", &graphIsFunctional);
+    ImGui::SetItemTooltip(
+        "For functional, contour, vector field and ODE graphs.");
+    showGraphTypeOptions();
 
     if (ImGui::Button("Confirm")) {
+      Graph& graph = graphs.at(editGraphIndex);
+
+      // Contour and ODE styles are not compiled in, only a new body or type
+      // compiles.
+      const bool isStyleChange = (graph.type == GraphType::CONTOUR ||
+                                  graph.type == GraphType::ODE) &&
+                                 graphType == static_cast<int>(graph.type) &&
+                                 graph.body == graphBody;
+
+      graph.levels = parseNumbers(graphLevels);
+      graph.seeds = parseNumbers(graphSeeds);
+      graph.odeMethod = static_cast<OdeMethod>(graphOdeMethod);
       graphs.at(editGraphIndex).isFunctional = graphIsFunctional;
+      graphs.at(editGraphIndex).type = static_cast<GraphType>(graphType);
+      graphs.at(editGraphIndex).colormap =
+          static_cast<Colormap>(graphColormap);
       graphs.at(editGraphIndex).body = std::string(graphBody);
       graphs.at(editGraphIndex).r = graphColor[0];
       graphs.at(editGraphIndex).g = graphColor[1];
       graphs.at(editGraphIndex).b = graphColor[2];
       graphs.at(editGraphIndex).thickness = graphThickness;
       ImGui::CloseCurrentPopup();
-      graphs.at(editGraphIndex).isValid = makeShaderProgram();
+
+      if (isStyleChange)
+        updateGraphStyles();
+      else
+        graphs.at(editGraphIndex).isValid = makeShaderProgram();
     }
 
     ImGui::SameLine();
@@ -628,6 +1233,14 @@ void SGCEngine::processGUI() {
         ini[graph.name]["thickness"] = std::to_string(graph.thickness);
         ini[graph.name]["isFunctional"] = std::to_string(graph.isFunctional);
         ini[graph.name]["isVisible"] = std::to_string(graph.isVisible);
+        ini[graph.name]["type"] =
+            std::to_string(static_cast<int>(graph.type));
+        ini[graph.name]["colormap"] =
+            std::to_string(static_cast<int>(graph.colormap));
+        ini[graph.name]["levels"] = formatNumbers(graph.levels);
+        ini[graph.name]["seeds"] = formatNumbers(graph.seeds);
+        ini[graph.name]["method"] =
+            std::to_string(static_cast<int>(graph.odeMethod));
       }
 
       bool a = file.generate(ini);
@@ -699,6 +1312,22 @@ void SGCEngine::processGUI() {
                                  std::stof(ini[graph.first]["g"]),
                                  std::stof(ini[graph.first]["b"]), 1.0));
           graphs.back().isVisible = std::stoi(ini[graph.first]["isVisible"]);
+
+          // Savefiles from before graph types have plain graphs.
+          if (ini[graph.first].has("type"))
+            graphs.back().type =
+                static_cast<GraphType>(std::stoi(ini[graph.first]["type"]));
+          if (ini[graph.first].has("colormap"))
+            graphs.back().colormap = static_cast<Colormap>(
+                std::stoi(ini[graph.first]["colormap"]));
+          if (ini[graph.first].has("levels"))
+            graphs.back().levels = parseNumbers(ini[graph.first]["levels"]);
+          if (ini[graph.first].has("seeds"))
+            graphs.back().seeds = parseNumbers(ini[graph.first]["seeds"]);
+          if (ini[graph.first].has("method"))
+            graphs.back().odeMethod = static_cast<OdeMethod>(
+                std::stoi(ini[graph.first]["method"]));
+
           graphs.back().isValid = makeShaderProgram();
         }
       }
@@ -742,33 +1371,800 @@ void SGCEngine::processGUI() {
   }
 }
 
+View SGCEngine::makeView() const {
+  View view;
+  view.width = windowWidth;
+  view.height = windowHeight;
+  view.positionX = positionX;
+  view.positionY = positionY;
+  view.zoom = zoom;
+  setGridPeriods(view, std::max<float>((float)(windowWidth),
+                                       (float)(windowHeight)));
+  view.t = animationClock.getTime();
+  view.parameter = parameter;
+  return view;
+}
+
 void SGCEngine::draw() {
   glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT);
 
+  const View view = makeView();
+
+  // A minimized window has an empty framebuffer.
+  if (view.width <= 0 || view.height <= 0) return;
+
+  drawnResolutionScale = 1.0f;
+
+  if (renderBackend == RenderBackend::SOFTWARE) {
+    drawSoftware(view);
+    return;
+  }
+
+  if (isParameterSweep) {
+    drawSweepScene(view);
+    return;
+  }
+
+  if (splitViewCount > 1) {
+    drawSplitScene(makeSplitViews());
+    return;
+  }
+
+  const bool isIdle = !isAnimated() &&
+                      lastDrawnGraphsRevision == graphsRevision &&
+                      hasSameScale(view, lastDrawnView) &&
+                      hasSamePosition(view, lastDrawnView);
+
+  // One more frame starts the still once the view stops.
+  if ((isEdgeSupersampling || isTemporalAccumulation) && !isIdle &&
+      !isAnimated())
+    requestRedraw();
+
+  // Heatmaps are normalized to the range of the whole view, so pixels shaded
+  // for a tile or a panned strip would not match their neighbours.
+  const bool isCacheable = heatmapRenderer.isEmpty();
+
+  // A stepped clock holds t over several display frames. The cached layer
+  // then shades the step once at full resolution and reuses it.
+  const bool isHeldStep = isAnimated() && animationClock.isStepped() &&
+                          lastDrawnGraphsRevision == graphsRevision &&
+                          hasSameTime(view, lastDrawnView) &&
+                          hasSameScale(view, lastDrawnView);
+
+  if (isEdgeSupersampling && isIdle)
+    drawSupersampledScene(view);
+  else if (isTemporalAccumulation && isIdle)
+    drawAccumulatedScene(view);
+  else if (isTileCaching && isCacheable && !isAnimated())
+    drawTiledGraphs(view);
+  else if (isProgressiveRendering && !isAnimated())
+    drawProgressive(view);
+  else if (isDynamicResolution && !isIdle &&
+           !(isHeldStep && isGraphLayerCaching && isCacheable))
+    drawScaledGraphs(view);
+  else if (isGraphLayerCaching && isCacheable &&
+           (!isAnimated() || animationClock.isStepped()))
+    drawCachedGraphLayer(view);
+  else
+    drawScene(view);
+}
+
+void SGCEngine::drawTiledGraphs(const View& view) {
+  // Tiles are shaded at the power of two zoom nearest to the camera zoom.
+  const int level = static_cast<int>(std::lround(std::log2(view.zoom)));
+
+  const float windowExtent =
+      static_cast<float>(std::max(view.width, view.height));
+
+  View tileView = view;
+  tileView.width = TileCache::tileSize;
+  tileView.height = TileCache::tileSize;
+
+  // The grid period follows the level zoom, so every level has its own hash.
+  // Leaves tileView at the zoom and grid of the level.
+  auto getContentHash = [&](int tileLevel) {
+    tileView.zoom = std::ldexp(1.0f, tileLevel);
+    setGridPeriods(tileView, windowExtent);
+    return graphsHash ^ std::hash<float>{}(tileView.sublinePeriod) ^
+           (std::hash<float>{}(tileView.parameter) << 1);
+  };
+
+  std::size_t coarserHashes[5];
+  for (int coarser = 4; coarser >= 1; coarser--)
+    coarserHashes[coarser] = getContentHash(level - coarser);
+  const std::size_t contentHash = getContentHash(level);
+  const float tileWorldSize =
+      static_cast<float>(TileCache::tileSize) / tileView.zoom;
+
+  const float halfWidth = static_cast<float>(view.width) * 0.5f / view.zoom;
+  const float halfHeight = static_cast<float>(view.height) * 0.5f / view.zoom;
+  const int beginX = static_cast<int>(
+      std::floor((view.positionX - halfWidth) / tileWorldSize));
+  const int endX = static_cast<int>(
+      std::floor((view.positionX + halfWidth) / tileWorldSize));
+  const int beginY = static_cast<int>(
+      std::floor((view.positionY - halfHeight) / tileWorldSize));
+  const int endY = static_cast<int>(
+      std::floor((view.positionY + halfHeight) / tileWorldSize));
+
+  auto toScreen = [&](float worldX, float worldY) {
+    return ImVec2((worldX - view.positionX) / halfWidth,
+                  (worldY - view.positionY) / halfHeight);
+  };
+
+  int renderBudget = 4;
+  bool isPending = false;
+
+  for (int tileY = beginY; tileY <= endY; tileY++) {
+    for (int tileX = beginX; tileX <= endX; tileX++) {
+      const TileCache::Key key{contentHash, level, tileX, tileY};
+
+      const ImVec2 min = toScreen(static_cast<float>(tileX) * tileWorldSize,
+                                  static_cast<float>(tileY) * tileWorldSize);
+      const ImVec2 max =
+          toScreen(static_cast<float>(tileX + 1) * tileWorldSize,
+                   static_cast<float>(tileY + 1) * tileWorldSize);
+      const Rect destRect{min.x, min.y, max.x, max.y};
+
+      GLuint texture = tileCache.find(key);
+
+      if (texture != 0) {
+        tileCache.hits++;
+        drawTexture(texture, destRect, {0.0f, 0.0f, 1.0f, 1.0f});
+        continue;
+      }
+
+      tileCache.misses++;
+
+      if (renderBudget == 0) {
+        // Show the nearest coarser tile until this one is rendered, or
+        // nothing, tiles over the budget wait for the next frames.
+        isPending = true;
+
+        for (int coarser = 1; coarser <= 4; coarser++) {
+          const int parentX = tileX >> coarser;
+          const int parentY = tileY >> coarser;
+          texture = tileCache.find(
+              {coarserHashes[coarser], level - coarser, parentX, parentY});
+          if (texture == 0) continue;
+
+          const float scale = 1.0f / static_cast<float>(1 << coarser);
+          const float u = static_cast<float>(tileX - (parentX << coarser)) * scale;
+          const float v = static_cast<float>(tileY - (parentY << coarser)) * scale;
+          drawTexture(texture, destRect, {u, v, u + scale, v + scale});
+          break;
+        }
+
+        continue;
+      }
+
+      renderBudget--;
+
+      RenderTarget& tile = tileCache.insert(key);
+      tile.bind();
+      tileView.positionX = (static_cast<float>(tileX) + 0.5f) * tileWorldSize;
+      tileView.positionY = (static_cast<float>(tileY) + 0.5f) * tileWorldSize;
+      drawScene(tileView);
+
+      glBindFramebuffer(GL_FRAMEBUFFER, 0);
+      glViewport(0, 0, windowWidth, windowHeight);
+
+      drawTexture(tile.texture, destRect, {0.0f, 0.0f, 1.0f, 1.0f});
+    }
+  }
+
+  if (isPending) requestRedraw();
+}
+
+void SGCEngine::drawScaledGraphs(const View& view) {
+  updateResolutionScale();
+
+  if (timerQueries[0] == 0) glGenQueries(3, timerQueries);
+
+  // The target keeps the window size, lower scales use its bottom left part,
+  // so changing the scale never reallocates it.
+  scaledTarget.resize(view.width, view.height);
+
+  View scaledView = view;
+  scaledView.width = std::max(
+      1, static_cast<int>(
+             std::lround(static_cast<float>(view.width) * resolutionScale)));
+  scaledView.height = std::max(
+      1, static_cast<int>(
+             std::lround(static_cast<float>(view.height) * resolutionScale)));
+  scaledView.zoom = view.zoom * static_cast<float>(scaledView.width) /
+                    static_cast<float>(view.width);
+
+  scaledTarget.bind();
+  glViewport(0, 0, scaledView.width, scaledView.height);
+
+  glBeginQuery(GL_TIME_ELAPSED, timerQueries[timerQueryIndex]);
+  drawScene(scaledView);
+  glEndQuery(GL_TIME_ELAPSED);
+
+  timerQueryPixels[timerQueryIndex] = scaledView.width * scaledView.height;
+  timerQueryIndex = (timerQueryIndex + 1) % 3;
+
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glViewport(0, 0, windowWidth, windowHeight);
+
+  drawTexture(scaledTarget.texture, {-1.0f, -1.0f, 1.0f, 1.0f},
+              {0.0f, 0.0f,
+               static_cast<float>(scaledView.width) /
+                   static_cast<float>(view.width),
+               static_cast<float>(scaledView.height) /
+                   static_cast<float>(view.height)});
+
+  drawnResolutionScale = static_cast<float>(scaledView.width) /
+                         static_cast<float>(view.width);
+
+  // One more frame brings back full resolution once the view stops.
+  if (scaledView.width != view.width || scaledView.height != view.height)
+    requestRedraw();
+}
+
+void SGCEngine::updateResolutionScale() {
+  constexpr float minResolutionScale = 0.25f;
+
+  // Results are read a few frames late so the CPU never waits for the GPU.
+  for (int i = 0; i < 3; i++) {
+    if (timerQueryPixels[i] == 0) continue;
+
+    GLint isAvailable = GL_FALSE;
+    glGetQueryObjectiv(timerQueries[i], GL_QUERY_RESULT_AVAILABLE,
+                       &isAvailable);
+    if (isAvailable == GL_FALSE) continue;
+
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64v(timerQueries[i], GL_QUERY_RESULT, &elapsed);
+    graphPassTime = static_cast<float>(elapsed) * 1e-6f;
+
+    // Shading cost grows with the pixel count, so the scale of both sides
+    // follows the square root of the time ratio.
+    const float fullPassTime =
+        graphPassTime * static_cast<float>(windowWidth * windowHeight) /
+        static_cast<float>(timerQueryPixels[i]);
+    const float scale =
+        std::clamp(std::sqrt(targetFrameTime / std::max(fullPassTime, 1e-3f)),
+                   minResolutionScale, 1.0f);
+
+    resolutionScale += (scale - resolutionScale) * 0.5f;
+    timerQueryPixels[i] = 0;
+  }
+}
+
+// Layers from the bottom: grid, heatmaps, contours, vector fields, ODE curves,
+// plain graphs, then curves and columns outside the per pixel mode. Within a
+// layer earlier graphs are on top.
+void SGCEngine::drawScene(const View& view) {
+  pushCamera(view);
+  grid.draw(view);
+  heatmapRenderer.draw(view);
+  contourRenderer.draw();
+  vectorFieldRenderer.draw(view);
+  trajectoryRenderer.draw(view);
+  drawGraphs(view);
+  curveRenderer.draw(view);
+  columnRenderer.draw(view);
+}
+
+void SGCEngine::pushCamera(const View& view) {
+  const CameraUniforms camera = makeCameraUniforms(view);
+  uniformRing.push(cameraUniformBinding, &camera, sizeof(camera));
+}
+
+void SGCEngine::drawGraphs(const View& view, int sampleStep, int skipStep) {
+  drawGraphs(std::vector<View>{view}, sampleStep, skipStep);
+}
+
+void SGCEngine::drawGraphs(const std::vector<View>& views, int sampleStep,
+                           int skipStep) {
+  // View rectangles are relative to the bound viewport.
+  GLint viewport[4];
+  glGetIntegerv(GL_VIEWPORT, viewport);
+
+  const std::size_t frameViewCount =
+      std::min(views.size(), static_cast<std::size_t>(maxFrameViews));
+  const std::vector<View> frameViews(
+      views.begin(),
+      views.begin() + static_cast<std::ptrdiff_t>(frameViewCount));
+
+  FrameUniforms frame = {};
+  frame.sampleStep = sampleStep;
+  frame.skipStep = skipStep;
+
+  for (std::size_t i = 0; i < frameViews.size(); i++)
+    frame.views[i] = makeViewUniforms(frameViews[i], viewport);
+
+  uniformRing.push(frameUniformBinding, &frame, sizeof(frame));
+
+  glBindVertexArray(displayVAO);
+  drawGraphInstances(frameViews);
+  glBindVertexArray(0);
+}
+
+void SGCEngine::drawSweptGraphs(const std::vector<View>& cells) {
+  GLint viewport[4];
+  glGetIntegerv(GL_VIEWPORT, viewport);
+
+  // Cells share the camera of the first view, the rectangles and values of a
+  // are per instance.
+  FrameUniforms frame = {};
+  frame.views[0] = makeViewUniforms(cells.front(), viewport);
+  frame.sampleStep = 1;
+  frame.cellCount = static_cast<GLint>(cells.size());
+
+  uniformRing.push(frameUniformBinding, &frame, sizeof(frame));
+
   glBindVertexArray(displayVAO);
+  parameterSweep.bindCells(cells);
+  drawGraphInstances(cells);
+  parameterSweep.unbindCells();
+  glBindVertexArray(0);
+}
+
+void SGCEngine::drawGraphInstances(const std::vector<View>& views) {
+  if (isGraphPasses) {
+    graphPasses.draw(views);
+    return;
+  }
+
   glUseProgram(shaderProgram);
 
-  glUniform2f(windowSizeUniformLocation, static_cast<GLfloat>(windowWidth),
-              static_cast<GLfloat>(windowHeight));
-  glUniform2f(positionUniformLocation, positionX, positionY);
-  glUniform1f(zoomUniformLocation, zoom);
-  glUniform1f(
-      sublinePeriodUniformLocation,
-      std::pow(10.0,
-               std::round(std::log10(std::max<float>((float)(windowWidth),
-                                                     (float)(windowHeight)) /
-                                     zoom))));
-  glUniform1f(
-      microlinePeriodUniformLocation,
-      std::pow(10.0,
-               std::round(std::log10(std::max<float>((float)(windowWidth),
-                                                     (float)(windowHeight)) /
-                                     zoom / 10.0))));
-  glUniform1f(timeUniformLocation, ImGui::GetTime());
+  // Coverage output is blended over the grid like the separate passes.
+  if (isCoverageShading) {
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                        GL_ONE_MINUS_SRC_ALPHA);
+  }
+
+  glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0,
+                          static_cast<GLsizei>(views.size()));
+
+  glDisable(GL_BLEND);
+  glUseProgram(0);
+}
+
+std::vector<View> SGCEngine::makeSplitViews() const {
+  // Two or three views side by side, four in a 2x2 grid, the first view at
+  // the top left follows the main camera.
+  const int columns = splitViewCount == 4 ? 2 : splitViewCount;
+  const int rows = splitViewCount == 4 ? 2 : 1;
+  const View mainView = makeView();
+
+  std::vector<View> views;
+
+  for (int i = 0; i < splitViewCount; i++) {
+    const int column = i % columns;
+    const int row = rows - 1 - i / columns;
+
+    View view = mainView;
+    view.originX = windowWidth * column / columns;
+    view.originY = windowHeight * row / rows;
+    view.width = windowWidth * (column + 1) / columns - view.originX;
+    view.height = windowHeight * (row + 1) / rows - view.originY;
+
+    if (i > 0) {
+      const SplitCamera& camera = splitCameras[i - 1];
+      view.positionX = camera.positionX;
+      view.positionY = camera.positionY;
+      view.zoom = camera.zoom;
+      view.t += camera.timeOffset;
+    }
+
+    setGridPeriods(view, static_cast<float>(std::max(view.width, view.height)));
+    views.push_back(view);
+  }
+
+  return views;
+}
+
+void SGCEngine::drawSplitScene(const std::vector<View>& views, bool areCells) {
+  // Grids, curves and columns are drawn per viewport, the per pixel graphs of
+  // all views are one instanced draw of the same programs.
+  glEnable(GL_SCISSOR_TEST);
+
+  for (const auto& view : views) {
+    glViewport(view.originX, view.originY, view.width, view.height);
+    glScissor(view.originX, view.originY, view.width, view.height);
+    pushCamera(view);
+    grid.draw(view);
+    heatmapRenderer.draw(view);
+    contourRenderer.draw();
+    vectorFieldRenderer.draw(view);
+    trajectoryRenderer.draw(view);
+  }
+
+  glDisable(GL_SCISSOR_TEST);
+  glViewport(0, 0, windowWidth, windowHeight);
+
+  if (areCells)
+    drawSweptGraphs(views);
+  else
+    drawGraphs(views);
+
+  glEnable(GL_SCISSOR_TEST);
+
+  for (const auto& view : views) {
+    glViewport(view.originX, view.originY, view.width, view.height);
+    glScissor(view.originX, view.originY, view.width, view.height);
+    pushCamera(view);
+    curveRenderer.draw(view);
+    columnRenderer.draw(view);
+  }
+
+  glDisable(GL_SCISSOR_TEST);
+  glViewport(0, 0, windowWidth, windowHeight);
+}
+
+void SGCEngine::drawSweepScene(const View& view) {
+  const std::vector<View> cells = parameterSweep.makeCells(view);
+
+  drawSplitScene(cells, true);
+
+  // Values of a at the top left of every cell.
+  ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+
+  for (const auto& cell : cells) {
+    char label[32];
+    std::snprintf(label, sizeof(label), "a = %.3g", cell.parameter);
+    drawList->AddText(
+        ImVec2(static_cast<float>(cell.originX) + 3.0f,
+               static_cast<float>(windowHeight - cell.originY - cell.height) +
+                   1.0f),
+        IM_COL32(255, 255, 255, 200), label);
+  }
+}
+
+void SGCEngine::drawProgressive(const View& view) {
+  // Only the per pixel graphs are progressive. Every pass shades the pixels on
+  // its sample lattice that the previous, coarser pass did not shade into a
+  // transparent layer, which is resolved from the nearest sample between the
+  // other layers. Those are drawn at full resolution every frame.
+  const bool isRestart = progressiveTarget.resize(view.width, view.height) ||
+                         progressiveRevision != graphsRevision ||
+                         !hasSameScale(view, progressiveView) ||
+                         !hasSamePosition(view, progressiveView);
+
+  progressiveTarget.bind();
+
+  if (isRestart) {
+    progressiveView = view;
+    progressiveRevision = graphsRevision;
+    progressiveStep = 4;
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawGraphs(view, progressiveStep, 0);
+  } else if (progressiveStep > 1) {
+    drawGraphs(view, progressiveStep / 2, progressiveStep);
+    progressiveStep /= 2;
+  }
+
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glViewport(0, 0, windowWidth, windowHeight);
+
+  pushCamera(view);
+  grid.draw(view);
+  heatmapRenderer.draw(view);
+  contourRenderer.draw();
+  vectorFieldRenderer.draw(view);
+  trajectoryRenderer.draw(view);
+
+  // The layer holds colors premultiplied by coverage.
+  glBindVertexArray(displayVAO);
+  glUseProgram(resolveProgram);
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, progressiveTarget.texture);
+
+  glUniform1i(resolveSampleStepUniformLocation, progressiveStep);
 
   glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
+  glDisable(GL_BLEND);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glBindVertexArray(0);
+  glUseProgram(0);
+
+  curveRenderer.draw(view);
+  columnRenderer.draw(view);
+
+  if (progressiveStep > 1) requestRedraw();
+}
+
+void SGCEngine::drawSupersampledScene(const View& view) {
+  // The still is shaded once and shown until the view or the graphs change.
+  const bool isRestart = supersampledTarget.resize(view.width, view.height) ||
+                         supersampledRevision != graphsRevision ||
+                         !hasSameScale(view, supersampledView) ||
+                         !hasSamePosition(view, supersampledView);
+
+  if (isRestart) {
+    supersampledView = view;
+    supersampledRevision = graphsRevision;
+
+    supersampledTarget.bind();
+    pushCamera(view);
+    grid.draw(view);
+    heatmapRenderer.draw(view);
+    contourRenderer.draw();
+    vectorFieldRenderer.draw(view);
+    trajectoryRenderer.draw(view);
+    edgeSupersampler.draw(view);
+    curveRenderer.draw(view);
+    columnRenderer.draw(view);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, windowWidth, windowHeight);
+  }
+
+  drawTexture(supersampledTarget.texture, {-1.0f, -1.0f, 1.0f, 1.0f},
+              {0.0f, 0.0f, 1.0f, 1.0f});
+}
+
+void SGCEngine::drawAccumulatedScene(const View& view) {
+  // Every idle frame shades the scene with the next jitter and adds it to the
+  // running mean, the converged mean is shown without shading.
+  const bool isRestart =
+      accumulationTarget.resize(view.width, view.height, GL_RGBA32F) ||
+      accumulationRevision != graphsRevision ||
+      !hasSameScale(view, accumulationView) ||
+      !hasSamePosition(view, accumulationView);
+
+  if (isRestart) {
+    accumulationView = view;
+    accumulationRevision = graphsRevision;
+    accumulatedFrames = 0;
+
+    accumulationTarget.bind();
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+  }
+
+  if (accumulatedFrames < accumulationFrameCount) {
+    View jitteredView = view;
+    setJitter(jitteredView, accumulatedFrames);
+
+    jitteredTarget.resize(view.width, view.height);
+    jitteredTarget.bind();
+    drawScene(jitteredView);
+
+    // Frame n is weighted 1 / (n + 1), so the target stays the mean.
+    accumulationTarget.bind();
+    glEnable(GL_BLEND);
+    glBlendColor(0.0f, 0.0f, 0.0f,
+                 1.0f / static_cast<float>(accumulatedFrames + 1));
+    glBlendFunc(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA);
+    drawTexture(jitteredTarget.texture, {-1.0f, -1.0f, 1.0f, 1.0f},
+                {0.0f, 0.0f, 1.0f, 1.0f});
+    glDisable(GL_BLEND);
+
+    accumulatedFrames++;
+    requestRedraw();
+  }
+
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glViewport(0, 0, windowWidth, windowHeight);
+
+  drawTexture(accumulationTarget.texture, {-1.0f, -1.0f, 1.0f, 1.0f},
+              {0.0f, 0.0f, 1.0f, 1.0f});
+}
+
+void SGCEngine::drawCachedGraphLayer(const View& view) {
+  RenderTarget* layer = &graphLayers[graphLayerIndex];
+
+  const float shiftX = (view.positionX - graphLayerView.positionX) * view.zoom;
+  const float shiftY = (view.positionY - graphLayerView.positionY) * view.zoom;
+  const int dx = static_cast<int>(std::lround(shiftX));
+  const int dy = static_cast<int>(std::lround(shiftY));
+
+  const bool isReusable =
+      !layer->resize(view.width, view.height) &&
+      graphLayerRevision == graphsRevision &&
+      hasSameScale(view, graphLayerView) &&
+      (!isAnimated() || hasSameTime(view, graphLayerView)) &&
+      std::abs(shiftX - static_cast<float>(dx)) < 0.05f &&
+      std::abs(shiftY - static_cast<float>(dy)) < 0.05f &&
+      std::abs(dx) < view.width && std::abs(dy) < view.height;
+
+  if (!isReusable) {
+    graphLayerView = view;
+    layer->bind();
+    drawScene(graphLayerView);
+  } else if (dx != 0 || dy != 0) {
+    // Keep the position the cached pixels were shaded at, so rounding never
+    // accumulates into drift.
+    graphLayerView.positionX += static_cast<float>(dx) / view.zoom;
+    graphLayerView.positionY += static_cast<float>(dy) / view.zoom;
+
+    RenderTarget& shifted = graphLayers[1 - graphLayerIndex];
+    shifted.resize(view.width, view.height);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, layer->framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, shifted.framebuffer);
+    glBlitFramebuffer(std::max(dx, 0), std::max(dy, 0),
+                      view.width + std::min(dx, 0),
+                      view.height + std::min(dy, 0), std::max(-dx, 0),
+                      std::max(-dy, 0), view.width - std::max(dx, 0),
+                      view.height - std::max(dy, 0), GL_COLOR_BUFFER_BIT,
+                      GL_NEAREST);
+
+    shifted.bind();
+    glEnable(GL_SCISSOR_TEST);
+
+    if (dx != 0) {
+      glScissor(dx > 0 ? view.width - dx : 0, 0, std::abs(dx), view.height);
+      drawScene(graphLayerView);
+    }
+
+    if (dy != 0) {
+      glScissor(0, dy > 0 ? view.height - dy : 0, view.width, std::abs(dy));
+      drawScene(graphLayerView);
+    }
+
+    glDisable(GL_SCISSOR_TEST);
+
+    graphLayerIndex = 1 - graphLayerIndex;
+    layer = &shifted;
+  }
+
+  graphLayerRevision = graphsRevision;
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, layer->framebuffer);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+  glBlitFramebuffer(0, 0, view.width, view.height, 0, 0, view.width,
+                    view.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  glViewport(0, 0, windowWidth, windowHeight);
+}
+
+void SGCEngine::drawSoftware(const View& view) {
+  if (!softwareRenderer) softwareRenderer = std::make_unique<SoftwareRenderer>();
+
+  if (softwareGraphsRevision != graphsRevision) {
+    softwareRenderer->setGraphs(graphs);
+    softwareGraphsRevision = graphsRevision;
+  }
+
+  softwareRenderer->render(view);
+
+  if (softwareTexture == 0) {
+    glGenTextures(1, &softwareTexture);
+    glBindTexture(GL_TEXTURE_2D, softwareTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  }
+
+  glBindTexture(GL_TEXTURE_2D, softwareTexture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+  if (softwareTextureWidth != view.width ||
+      softwareTextureHeight != view.height) {
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, view.width, view.height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE,
+                 softwareRenderer->getPixels().data());
+    softwareTextureWidth = view.width;
+    softwareTextureHeight = view.height;
+  } else
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, view.width, view.height, GL_RGBA,
+                    GL_UNSIGNED_BYTE, softwareRenderer->getPixels().data());
+
+  drawTexture(softwareTexture, {-1.0f, -1.0f, 1.0f, 1.0f},
+              {0.0f, 0.0f, 1.0f, 1.0f});
+}
+
+void SGCEngine::drawMinimap(const View& view) {
+  if (view.width <= 0 || view.height <= 0) return;
+
+  // The minimap covers minimapExtent times the view it was shaded for and
+  // keeps the window aspect, it is shown at twice its resolution.
+  const int width = minimapResolution;
+  const int height = std::max(minimapResolution * view.height / view.width, 1);
+
+  const float halfWidth = static_cast<float>(view.width) * 0.5f / view.zoom;
+  const float halfHeight = static_cast<float>(view.height) * 0.5f / view.zoom;
+  float minimapHalfWidth =
+      static_cast<float>(minimapView.width) * 0.5f / minimapView.zoom;
+  float minimapHalfHeight =
+      static_cast<float>(minimapView.height) * 0.5f / minimapView.zoom;
+
+  const bool isInside =
+      std::abs(view.positionX - minimapView.positionX) + halfWidth <=
+          minimapHalfWidth &&
+      std::abs(view.positionY - minimapView.positionY) + halfHeight <=
+          minimapHalfHeight;
+
+  // Zooming in as far again as the minimap extends shades a closer one.
+  const bool isTooSmall =
+      halfWidth * minimapExtent * minimapExtent < minimapHalfWidth;
+
+  const bool isStale = minimapTarget.resize(width, height) ||
+                       minimapRevision != graphsRevision || !isInside ||
+                       isTooSmall ||
+                       std::isless(minimapView.parameter, view.parameter) ||
+                       std::isgreater(minimapView.parameter, view.parameter);
+
+  if (isStale) {
+    minimapView = view;
+    minimapView.width = width;
+    minimapView.height = height;
+    minimapView.originX = 0;
+    minimapView.originY = 0;
+    minimapView.jitterX = 0.0f;
+    minimapView.jitterY = 0.0f;
+    minimapView.zoom = view.zoom * static_cast<float>(width) /
+                       (static_cast<float>(view.width) * minimapExtent);
+    setGridPeriods(minimapView, static_cast<float>(std::max(width, height)));
+    minimapRevision = graphsRevision;
+    minimapHalfWidth = halfWidth * minimapExtent;
+    minimapHalfHeight = static_cast<float>(height) * 0.5f / minimapView.zoom;
+
+    minimapTarget.bind();
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawScene(minimapView);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, windowWidth, windowHeight);
+  }
+
+  const float margin = 10.0f;
+  const float displayWidth = static_cast<float>(width * 2);
+  const float displayHeight = static_cast<float>(height * 2);
+  const float screenWidth = static_cast<float>(windowWidth);
+  const float screenHeight = static_cast<float>(windowHeight);
+  const float screenX0 = screenWidth - margin - displayWidth;
+  const float screenY0 = screenHeight - margin;
+
+  drawTexture(minimapTarget.texture,
+              {screenX0 / screenWidth * 2.0f - 1.0f,
+               margin / screenHeight * 2.0f - 1.0f,
+               (screenX0 + displayWidth) / screenWidth * 2.0f - 1.0f,
+               (margin + displayHeight) / screenHeight * 2.0f - 1.0f},
+              {0.0f, 0.0f, 1.0f, 1.0f});
+
+  // Interface coordinates start at the top left.
+  auto toScreen = [&](float worldX, float worldY) {
+    const float u = (worldX - minimapView.positionX + minimapHalfWidth) /
+                    (minimapHalfWidth * 2.0f);
+    const float v = (worldY - minimapView.positionY + minimapHalfHeight) /
+                    (minimapHalfHeight * 2.0f);
+    return ImVec2(screenX0 + u * displayWidth, screenY0 - v * displayHeight);
+  };
+
+  ImDrawList* drawList = ImGui::GetBackgroundDrawList();
+  drawList->AddRect(ImVec2(screenX0, screenY0 - displayHeight),
+                    ImVec2(screenX0 + displayWidth, screenY0),
+                    IM_COL32(255, 255, 255, 160));
+  drawList->AddRect(toScreen(view.positionX - halfWidth,
+                             view.positionY + halfHeight),
+                    toScreen(view.positionX + halfWidth,
+                             view.positionY - halfHeight),
+                    IM_COL32(255, 200, 0, 255));
+}
+
+void SGCEngine::drawTexture(GLuint texture, const Rect& destRect,
+                            const Rect& sourceRect) {
+  glBindVertexArray(displayVAO);
+  glUseProgram(textureProgram);
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, texture);
+
+  glUniform4f(textureDestRectUniformLocation, destRect.x0, destRect.y0,
+              destRect.x1, destRect.y1);
+  glUniform4f(textureSourceRectUniformLocation, sourceRect.x0, sourceRect.y0,
+              sourceRect.x1, sourceRect.y1);
+
+  glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
   glBindVertexArray(0);
   glUseProgram(0);
 }
@@ -777,11 +2173,16 @@ void SGCEngine::windowSizeCallback(int width, int height) {
   glViewport(0, 0, width, height);
   windowWidth = width;
   windowHeight = height;
+  requestRedraw();
 }
 
 void SGCEngine::scrollCallback(double offsetX, double offsetY) {
+  requestRedraw();
+
   if (ImGui::GetIO().WantCaptureMouse) return;
 
+  framePacer.addInput(glfwGetTime());
+
   if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS) {
     double cursorX, cursorY;
     glfwGetCursorPos(window, &cursorX, &cursorY);
@@ -801,6 +2202,8 @@ void SGCEngine::scrollCallback(double offsetX, double offsetY) {
 }
 
 void SGCEngine::keyCallback(int key, int scancode, int action, int mods) {
+  requestRedraw();
+
   if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
     glfwSetWindowShouldClose(window, true);
 }
\ No newline at end of file
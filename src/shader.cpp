@@ -0,0 +1,89 @@
+#include <SGC/shader.hpp>
+
+GLuint makeProgram(const GLchar* vertexSource, const GLchar* fragmentSource) {
+  GLint shaderSetupSuccess;
+  static GLchar shaderSetupInfoLog[GL_INFO_LOG_LENGTH];
+
+  GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
+
+  glShaderSource(vertexShader, 1, &vertexSource, nullptr);
+  glCompileShader(vertexShader);
+
+  glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &shaderSetupSuccess);
+
+  if (!shaderSetupSuccess) {
+    glGetShaderInfoLog(vertexShader, GL_INFO_LOG_LENGTH, nullptr, shaderSetupInfoLog);
+    glDeleteShader(vertexShader);
+    return 0;
+  }
+
+  GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+
+  glShaderSource(fragmentShader, 1, &fragmentSource, nullptr);
+  glCompileShader(fragmentShader);
+
+  glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &shaderSetupSuccess);
+
+  if (!shaderSetupSuccess) {
+    glGetShaderInfoLog(fragmentShader, GL_INFO_LOG_LENGTH, nullptr, shaderSetupInfoLog);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    return 0;
+  }
+
+  GLuint shaderProgram = glCreateProgram();
+
+  glAttachShader(shaderProgram, vertexShader);
+  glAttachShader(shaderProgram, fragmentShader);
+
+  glLinkProgram(shaderProgram);
+
+  glDeleteShader(vertexShader);
+  glDeleteShader(fragmentShader);
+
+  glGetProgramiv(shaderProgram, GL_LINK_STATUS, &shaderSetupSuccess);
+
+  if (!shaderSetupSuccess) {
+    glGetProgramInfoLog(shaderProgram, GL_INFO_LOG_LENGTH, nullptr, shaderSetupInfoLog);
+    glDeleteProgram(shaderProgram);
+    return 0;
+  }
+
+  return shaderProgram;
+}
+
+GLuint makeComputeProgram(const GLchar* computeSource) {
+  GLint shaderSetupSuccess;
+  static GLchar shaderSetupInfoLog[GL_INFO_LOG_LENGTH];
+
+  GLuint computeShader = glCreateShader(GL_COMPUTE_SHADER);
+
+  glShaderSource(computeShader, 1, &computeSource, nullptr);
+  glCompileShader(computeShader);
+
+  glGetShaderiv(computeShader, GL_COMPILE_STATUS, &shaderSetupSuccess);
+
+  if (!shaderSetupSuccess) {
+    glGetShaderInfoLog(computeShader, GL_INFO_LOG_LENGTH, nullptr, shaderSetupInfoLog);
+    glDeleteShader(computeShader);
+    return 0;
+  }
+
+  GLuint shaderProgram = glCreateProgram();
+
+  glAttachShader(shaderProgram, computeShader);
+
+  glLinkProgram(shaderProgram);
+
+  glDeleteShader(computeShader);
+
+  glGetProgramiv(shaderProgram, GL_LINK_STATUS, &shaderSetupSuccess);
+
+  if (!shaderSetupSuccess) {
+    glGetProgramInfoLog(shaderProgram, GL_INFO_LOG_LENGTH, nullptr, shaderSetupInfoLog);
+    glDeleteProgram(shaderProgram);
+    return 0;
+  }
+
+  return shaderProgram;
+}
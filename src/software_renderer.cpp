@@ -0,0 +1,178 @@
+#include <SGC/error.hpp>
+#include <SGC/software_renderer.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+std::uint32_t packColor(float r, float g, float b) {
+  auto channel = [](float value) {
+    return static_cast<std::uint32_t>(
+        std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+  };
+  return channel(r) | channel(g) << 8 | channel(b) << 16 | 0xFF000000u;
+}
+
+bool isEqualApprox(float a, float b, float c) {
+  return std::abs(a - b) <= c * 0.5f;
+}
+
+float gridOffset(float value, float period) {
+  return (value / period - std::round(value / period)) * period;
+}
+
+}  // namespace
+
+void SoftwareRenderer::setGraphs(const std::vector<Graph>& sourceGraphs) {
+  graphs.clear();
+  skippedGraphs.clear();
+
+  for (const auto& graph : sourceGraphs) {
+    if (!graph.isVisible) continue;
+
+    if (graph.type != GraphType::PLAIN) {
+      skippedGraphs[graph.name] = "Only plain graphs are drawn on the CPU.";
+      continue;
+    }
+
+    std::shared_ptr<const CompiledExpression> expression;
+
+    try {
+      expression = compileExpression(graph.body);
+    } catch (const SGCError& error) {
+      skippedGraphs[graph.name] = error.msg;
+      continue;
+    }
+
+    const bool isColumnConstant =
+        graph.isFunctional && !expression->getExpression().usesY();
+
+    graphs.push_back({std::move(expression), graph.isFunctional,
+                      isColumnConstant, graph.thickness,
+                      packColor(graph.r, graph.g, graph.b)});
+  }
+}
+
+const std::unordered_map<std::string, std::string>&
+SoftwareRenderer::getSkippedGraphs() const {
+  return skippedGraphs;
+}
+
+void SoftwareRenderer::render(const View& view) {
+  pixels.resize(static_cast<std::size_t>(view.width) *
+                static_cast<std::size_t>(view.height));
+
+  const int tilesX = (view.width + tileSize - 1) / tileSize;
+  const int tilesY = (view.height + tileSize - 1) / tileSize;
+
+  threadPool.parallelFor(
+      static_cast<std::size_t>(tilesX * tilesY), [&](std::size_t index) {
+        renderTile(view, static_cast<int>(index) % tilesX,
+                   static_cast<int>(index) / tilesX);
+      });
+}
+
+const std::vector<std::uint32_t>& SoftwareRenderer::getPixels() const {
+  return pixels;
+}
+
+std::size_t SoftwareRenderer::getThreadCount() const {
+  return threadPool.getThreadCount();
+}
+
+void SoftwareRenderer::renderTile(const View& view, int tileX, int tileY) {
+  static const std::uint32_t axisColor = packColor(0.0f, 0.0f, 0.0f);
+  static const std::uint32_t sublineColor = packColor(0.65f, 0.65f, 0.65f);
+  static const std::uint32_t microlineColor = packColor(0.85f, 0.85f, 0.85f);
+  static const std::uint32_t backgroundColor = packColor(1.0f, 1.0f, 1.0f);
+
+  const float pixelSize = 1.0f / view.zoom;
+  const int beginX = tileX * tileSize;
+  const int beginY = tileY * tileSize;
+  const std::size_t width =
+      static_cast<std::size_t>(std::min(tileSize, view.width - beginX));
+  const int height = std::min(tileSize, view.height - beginY);
+
+  float worldX[tileSize];
+  float worldY[tileSize];
+  float values[tileSize];
+  bool isResolved[tileSize];
+
+  for (std::size_t i = 0; i < width; i++)
+    worldX[i] = (static_cast<float>(beginX + static_cast<int>(i)) + 0.5f -
+                 static_cast<float>(view.width) * 0.5f) *
+                    pixelSize +
+                view.positionX;
+
+  thread_local std::vector<float> columnValues;
+  columnValues.resize(graphs.size() * tileSize);
+
+  for (std::size_t g = 0; g < graphs.size(); g++)
+    if (graphs[g].isColumnConstant)
+      graphs[g].expression->evaluate(
+          {worldX, worldX, pixelSize, view.t, width},
+          columnValues.data() + g * tileSize);
+
+  for (int j = 0; j < height; j++) {
+    const float rowY = (static_cast<float>(beginY + j) + 0.5f -
+                        static_cast<float>(view.height) * 0.5f) *
+                           pixelSize +
+                       view.positionY;
+    std::fill_n(worldY, width, rowY);
+    std::fill_n(isResolved, width, false);
+
+    std::uint32_t* row = pixels.data() +
+                         static_cast<std::size_t>(beginY + j) *
+                             static_cast<std::size_t>(view.width) +
+                         static_cast<std::size_t>(beginX);
+    std::size_t remaining = width;
+
+    for (std::size_t g = 0; g < graphs.size() && remaining > 0; g++) {
+      const CompiledGraph& graph = graphs[g];
+      const float* graphValues = values;
+
+      if (graph.isColumnConstant)
+        graphValues = columnValues.data() + g * tileSize;
+      else
+        graph.expression->evaluate({worldX, worldY, pixelSize, view.t, width},
+                                   values);
+
+      for (std::size_t i = 0; i < width; i++) {
+        if (isResolved[i]) continue;
+
+        const bool isHit =
+            graph.isFunctional
+                ? isEqualApprox(graphValues[i], rowY,
+                                pixelSize * graph.thickness)
+                : std::isless(0.0f, std::abs(graphValues[i]));
+
+        if (!isHit) continue;
+
+        row[i] = graph.color;
+        isResolved[i] = true;
+        remaining--;
+      }
+    }
+
+    const float sublineY = gridOffset(rowY, view.sublinePeriod);
+    const float microlineY = gridOffset(rowY, view.microlinePeriod);
+
+    for (std::size_t i = 0; i < width && remaining > 0; i++) {
+      if (isResolved[i]) continue;
+
+      if (isEqualApprox(worldX[i], 0.0f, pixelSize) ||
+          isEqualApprox(rowY, 0.0f, pixelSize))
+        row[i] = axisColor;
+      else if (isEqualApprox(gridOffset(worldX[i], view.sublinePeriod), 0.0f,
+                             pixelSize) ||
+               isEqualApprox(sublineY, 0.0f, pixelSize))
+        row[i] = sublineColor;
+      else if (isEqualApprox(gridOffset(worldX[i], view.microlinePeriod), 0.0f,
+                             pixelSize) ||
+               isEqualApprox(microlineY, 0.0f, pixelSize))
+        row[i] = microlineColor;
+      else
+        row[i] = backgroundColor;
+    }
+  }
+}
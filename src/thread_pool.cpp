@@ -0,0 +1,83 @@
+#include <SGC/thread_pool.hpp>
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+    : ranges(std::make_unique<Range[]>(std::max<std::size_t>(threadCount, 1))) {
+  for (std::size_t i = 1; i < std::max<std::size_t>(threadCount, 1); i++)
+    workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(mutex);
+    isStopping = true;
+  }
+  startCondition.notify_all();
+
+  for (auto& worker : workers) worker.join();
+}
+
+std::size_t ThreadPool::getThreadCount() const { return workers.size() + 1; }
+
+void ThreadPool::parallelFor(std::size_t count,
+                             const std::function<void(std::size_t)>& task) {
+  if (count == 0) return;
+
+  const std::size_t participants = getThreadCount();
+
+  for (std::size_t i = 0; i < participants; i++) {
+    ranges[i].next.store(count * i / participants, std::memory_order_relaxed);
+    ranges[i].end = count * (i + 1) / participants;
+  }
+
+  {
+    std::lock_guard lock(mutex);
+    currentTask = &task;
+    activeWorkers = workers.size();
+    generation++;
+  }
+  startCondition.notify_all();
+
+  runTasks(0);
+
+  std::unique_lock lock(mutex);
+  doneCondition.wait(lock, [this] { return activeWorkers == 0; });
+  currentTask = nullptr;
+}
+
+void ThreadPool::workerLoop(std::size_t participant) {
+  std::size_t seenGeneration = 0;
+
+  while (true) {
+    {
+      std::unique_lock lock(mutex);
+      startCondition.wait(lock, [&] {
+        return isStopping || generation != seenGeneration;
+      });
+      if (isStopping) return;
+      seenGeneration = generation;
+    }
+
+    runTasks(participant);
+
+    {
+      std::lock_guard lock(mutex);
+      activeWorkers--;
+    }
+    doneCondition.notify_one();
+  }
+}
+
+void ThreadPool::runTasks(std::size_t participant) {
+  const std::size_t participants = getThreadCount();
+
+  for (std::size_t offset = 0; offset < participants; offset++) {
+    Range& range = ranges[(participant + offset) % participants];
+
+    while (true) {
+      std::size_t index = range.next.fetch_add(1, std::memory_order_relaxed);
+      if (index >= range.end) break;
+      (*currentTask)(index);
+    }
+  }
+}
@@ -0,0 +1,56 @@
+#include <SGC/tile_cache.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace {
+
+constexpr std::size_t tileBytes =
+    static_cast<std::size_t>(TileCache::tileSize) * TileCache::tileSize * 4;
+
+}  // namespace
+
+std::size_t TileCache::KeyHash::operator()(const Key& key) const {
+  std::size_t hash = key.contentHash;
+  for (int value : {key.level, key.x, key.y})
+    hash ^= std::hash<int>{}(value) + 0x9E3779B97F4A7C15ull + (hash << 6) +
+            (hash >> 2);
+  return hash;
+}
+
+GLuint TileCache::find(const Key& key) {
+  auto it = tiles.find(key);
+  if (it == tiles.end()) return 0;
+
+  usageOrder.splice(usageOrder.begin(), usageOrder, it->second.usage);
+  return it->second.target->texture;
+}
+
+RenderTarget& TileCache::insert(const Key& key) {
+  const std::size_t maxTiles =
+      std::max<std::size_t>(budgetMegabytes * 1024 * 1024 / tileBytes, 1);
+
+  while (tiles.size() >= maxTiles) {
+    tiles.erase(usageOrder.back());
+    usageOrder.pop_back();
+  }
+
+  usageOrder.push_front(key);
+
+  Entry& entry = tiles[key];
+  entry.target = std::make_unique<RenderTarget>();
+  entry.target->resize(tileSize, tileSize);
+  entry.usage = usageOrder.begin();
+
+  return *entry.target;
+}
+
+void TileCache::clear() {
+  tiles.clear();
+  usageOrder.clear();
+}
+
+std::size_t TileCache::getTileCount() const { return tiles.size(); }
+
+std::size_t TileCache::getMemoryUsage() const {
+  return tiles.size() * tileBytes;
+}
@@ -0,0 +1,412 @@
+#include <SGC/camera_block.hpp>
+#include <SGC/error.hpp>
+#include <SGC/shader.hpp>
+#include <SGC/trajectory_renderer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace {
+
+const std::string integrateSourceStart =                       //
+    "#version 430 core\n"                                      //
+    "#define pi 3.1415927410125732\n"                          //
+    "#define nan uintBitsToFloat(0x7fc00000u)\n"               //
+    "layout(local_size_x = 64) in;"                            //
+    "layout(std430, binding = 0) readonly buffer Seeds {"      //
+    "  vec2 seeds[];"                                          //
+    "};"                                                       //
+    "layout(std430, binding = 1) writeonly buffer Points {"    //
+    "  vec2 points[];"                                         //
+    "};"                                                       //
+    "uniform float t;"                                         //
+    "uniform float a;"                                         //
+    "uniform int seedCount;"                                   //
+    "uniform int method;"                                      //
+    "const int pointCount = " +                                //
+    std::to_string(TrajectoryRenderer::pointsPerTrajectory) +  //
+    ";"                                                        //
+    "const float stepSize = " +                                //
+    std::to_string(TrajectoryRenderer::stepSize) +             //
+    ";"                                                        //
+    "const float maxStep = " +                                 //
+    std::to_string(TrajectoryRenderer::maxAdaptiveStep) +      //
+    ";"                                                        //
+    "const float minStep = 1e-5;"                              //
+    "const float tolerance = 1e-4;"                            //
+    "bool isEqualApprox(float a, float b, float c) {"          //
+    "  return abs(a - b) <= c * 0.5;"                          //
+    "}"                                                        //
+    "vec2 system(vec2 point) {"                                //
+    "  float x = point.x;"                                     //
+    "  float y = point.y;"                                     //
+    "  return vec2(";
+
+// Even invocations follow the system from their seed, odd ones go backwards.
+// A curve ends where it stops, leaves 1e6 or stops being finite.
+const std::string integrateSourceEnd =                             //
+    ");"                                                           //
+    "}"                                                            //
+    "vec2 rk4(vec2 p, float h, float s) {"                         //
+    "  vec2 k1 = s * system(p);"                                   //
+    "  vec2 k2 = s * system(p + h * 0.5 * k1);"                    //
+    "  vec2 k3 = s * system(p + h * 0.5 * k2);"                    //
+    "  vec2 k4 = s * system(p + h * k3);"                          //
+    "  return p + h / 6.0 * (k1 + 2.0 * k2 + 2.0 * k3 + k4);"      //
+    "}"                                                            //
+    "vec2 dormandPrince(vec2 p, inout float h, float s) {"         //
+    "  vec2 next = vec2(nan);"                                     //
+    "  for (int attempt = 0; attempt < 12; attempt++) {"           //
+    "    vec2 k1 = s * system(p);"                                 //
+    "    vec2 k2 = s * system(p + h * (k1 / 5.0));"                //
+    "    vec2 k3 = s * system(p + h * (3.0 / 40.0 * k1"            //
+    "      + 9.0 / 40.0 * k2));"                                   //
+    "    vec2 k4 = s * system(p + h * (44.0 / 45.0 * k1"           //
+    "      - 56.0 / 15.0 * k2 + 32.0 / 9.0 * k3));"                //
+    "    vec2 k5 = s * system(p + h * (19372.0 / 6561.0 * k1"      //
+    "      - 25360.0 / 2187.0 * k2 + 64448.0 / 6561.0 * k3"        //
+    "      - 212.0 / 729.0 * k4));"                                //
+    "    vec2 k6 = s * system(p + h * (9017.0 / 3168.0 * k1"       //
+    "      - 355.0 / 33.0 * k2 + 46732.0 / 5247.0 * k3"            //
+    "      + 49.0 / 176.0 * k4 - 5103.0 / 18656.0 * k5));"         //
+    "    next = p + h * (35.0 / 384.0 * k1 + 500.0 / 1113.0 * k3"  //
+    "      + 125.0 / 192.0 * k4 - 2187.0 / 6784.0 * k5"            //
+    "      + 11.0 / 84.0 * k6);"                                   //
+    "    vec2 k7 = s * system(next);"                              //
+    "    vec2 difference = h * (71.0 / 57600.0 * k1"               //
+    "      - 71.0 / 16695.0 * k3 + 71.0 / 1920.0 * k4"             //
+    "      - 17253.0 / 339200.0 * k5 + 22.0 / 525.0 * k6"          //
+    "      - 1.0 / 40.0 * k7);"                                    //
+    "    float error = length(difference)"                         //
+    "      / (tolerance * (1.0 + length(p)));"                     //
+    "    if (isnan(error) || isinf(error)) return vec2(nan);"      //
+    "    float factor ="                                           //
+    "      clamp(0.9 * pow(max(error, 1e-10), -0.2), 0.2, 5.0);"   //
+    "    if (error <= 1.0 || h <= minStep) {"                      //
+    "      h = min(h * factor, maxStep);"                          //
+    "      return next;"                                           //
+    "    }"                                                        //
+    "    h = max(h * factor, minStep);"                            //
+    "  }"                                                          //
+    "  return next;"                                               //
+    "}"                                                            //
+    "void main() {"                                                //
+    "  int id = int(gl_GlobalInvocationID.x);"                     //
+    "  if (id >= seedCount * 2) return;"                           //
+    "  float s = (id & 1) == 0 ? 1.0 : -1.0;"                      //
+    "  int base = id * pointCount;"                                //
+    "  vec2 p = seeds[id >> 1];"                                   //
+    "  float h = stepSize;"                                        //
+    "  points[base] = p;"                                          //
+    "  int i = 1;"                                                 //
+    "  for (; i < pointCount; i++) {"                              //
+    "    vec2 next = method == 0 ? rk4(p, stepSize, s)"            //
+    "      : dormandPrince(p, h, s);"                              //
+    "    if (any(isnan(next)) || any(isinf(next))"                 //
+    "      || any(greaterThan(abs(next), vec2(1e6)))"              //
+    "      || length(next - p) < 1e-7) break;"                     //
+    "    points[base + i] = next;"                                 //
+    "    p = next;"                                                //
+    "  }"                                                          //
+    "  for (; i < pointCount; i++) points[base + i] = vec2(nan);"  //
+    "}";
+
+// Segment i joins points i and i + 1 of its curve, segments with a NaN end
+// are moved out of the view. Screen coordinates as in the curve renderer.
+const std::string lineVertexShaderSource =                               //
+    "#version 430 core\n"                                                //
+    "layout(std430, binding = 1) readonly buffer Points {"               //
+    "  vec2 points[];"                                                   //
+    "};" +                                                               //
+    std::string(cameraBlockSource) +                                     //
+    "uniform int pointCount;"                                            //
+    "uniform float halfWidth;"                                           //
+    "noperspective out float lineDistance;"                              //
+    "const int corners[6] = int[6](0, 1, 2, 2, 1, 3);"                   //
+    "void main() {"                                                      //
+    "  int segment = gl_VertexID / 6;"                                   //
+    "  int corner = corners[gl_VertexID % 6];"                           //
+    "  int index = segment / (pointCount - 1) * pointCount"              //
+    "    + segment % (pointCount - 1);"                                  //
+    "  vec2 p0 = (points[index] - position) * zoom + windowSize * 0.5;"  //
+    "  vec2 p1 = (points[index + 1] - position) * zoom"                  //
+    "    + windowSize * 0.5;"                                            //
+    "  if (any(isnan(p0)) || any(isnan(p1))) {"                          //
+    "    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);"                        //
+    "    lineDistance = 0.0;"                                            //
+    "    return;"                                                        //
+    "  }"                                                                //
+    "  vec2 direction = p1 - p0;"                                        //
+    "  direction = length(direction) > 1e-6"                             //
+    "    ? normalize(direction) : vec2(1.0, 0.0);"                       //
+    "  vec2 normal = vec2(-direction.y, direction.x);"                   //
+    "  float extent = halfWidth + 1.0;"                                  //
+    "  float side = (corner & 2) != 0 ? 1.0 : -1.0;"                     //
+    "  vec2 point = (corner & 1) != 0 ? p1 + direction * extent"         //
+    "    : p0 - direction * extent;"                                     //
+    "  point += normal * side * extent;"                                 //
+    "  lineDistance = side * extent;"                                    //
+    "  gl_Position = vec4(point / windowSize * 2.0 - 1.0, 0.0, 1.0);"    //
+    "}";
+
+const GLchar* lineFragmentShaderSource =                         //
+    "#version 430 core\n"                                        //
+    "noperspective in float lineDistance;"                       //
+    "out vec4 FragColor;"                                        //
+    "uniform float halfWidth;"                                   //
+    "uniform vec3 color;"                                        //
+    "void main() {"                                              //
+    "  float coverage ="                                         //
+    "    clamp(halfWidth + 0.5 - abs(lineDistance), 0.0, 1.0);"  //
+    "  if (coverage <= 0.0) discard;"                            //
+    "  FragColor = vec4(color, coverage);"                       //
+    "}";
+
+// A body with a comma outside parentheses is the system u, v, otherwise it
+// is dy/dx and the curve parameter is x.
+std::string getSystemSource(const std::string& body) {
+  int depth = 0;
+
+  for (char c : body) {
+    if (c == '(') depth++;
+    if (c == ')') depth--;
+    if (c == ',' && depth == 0) return body;
+  }
+
+  return "1.0, " + body;
+}
+
+bool isSame(float a, float b) {
+  return !std::isless(a, b) && !std::isgreater(a, b);
+}
+
+}  // namespace
+
+TrajectoryRenderer::~TrajectoryRenderer() { release(); }
+
+bool TrajectoryRenderer::setGraphs(const std::vector<Graph>& graphs) {
+  std::vector<System> newSystems;
+
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible || graph.type != GraphType::ODE) continue;
+
+    const std::string source = integrateSourceStart +
+                               getSystemSource(graph.body) +
+                               integrateSourceEnd;
+    const GLuint program = makeComputeProgram(source.c_str());
+
+    if (program == 0) {
+      for (const auto& system : newSystems) glDeleteProgram(system.program);
+      return false;
+    }
+
+    System system;
+    system.program = program;
+    system.timeUniformLocation = glGetUniformLocation(program, "t");
+    system.parameterUniformLocation = glGetUniformLocation(program, "a");
+    system.seedCountUniformLocation =
+        glGetUniformLocation(program, "seedCount");
+    system.methodUniformLocation = glGetUniformLocation(program, "method");
+    system.usesTime = graph.usesTime();
+    system.usesParameter = graph.usesParameter();
+
+    newSystems.push_back(std::move(system));
+  }
+
+  releaseSystems();
+  systems = std::move(newSystems);
+  setStyles(graphs);
+
+  return true;
+}
+
+void TrajectoryRenderer::setStyles(const std::vector<Graph>& graphs) {
+  std::size_t i = 0;
+
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible || graph.type != GraphType::ODE) continue;
+    if (i == systems.size()) break;
+
+    System& system = systems[i++];
+    const std::size_t seedCount =
+        std::min<std::size_t>(graph.seeds.size() / 2, maxSeeds);
+    const std::vector<GLfloat> seeds(
+        graph.seeds.begin(),
+        graph.seeds.begin() + static_cast<std::ptrdiff_t>(seedCount * 2));
+
+    if (seeds != system.seeds || graph.odeMethod != system.method)
+      releaseIntegrations(system);
+
+    system.seeds = seeds;
+    system.method = graph.odeMethod;
+    system.color[0] = graph.r;
+    system.color[1] = graph.g;
+    system.color[2] = graph.b;
+    system.halfWidth = std::max(graph.thickness * 0.5f, 0.5f);
+  }
+}
+
+void TrajectoryRenderer::draw(const View& view) {
+  if (systems.empty()) return;
+
+  if (lineProgram == 0) create();
+
+  std::vector<GLuint> pointBuffers;
+  pointBuffers.reserve(systems.size());
+  for (auto& system : systems)
+    pointBuffers.push_back(getPointBuffer(system, view));
+
+  glBindVertexArray(vertexArray);
+  glUseProgram(lineProgram);
+  glDisable(GL_CULL_FACE);
+  glEnable(GL_BLEND);
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                      GL_ONE_MINUS_SRC_ALPHA);
+
+  for (std::size_t i = systems.size(); i-- > 0;) {
+    const System& system = systems[i];
+    if (system.seeds.empty()) continue;
+
+    // The line program is shared, so the style is set per system.
+    glUniform1f(halfWidthUniformLocation, system.halfWidth);
+    glUniform3fv(colorUniformLocation, 1, system.color);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, pointBuffers[i]);
+
+    // Two curves per seed.
+    const GLsizei curveCount =
+        static_cast<GLsizei>(system.seeds.size() / 2) * 2;
+    const GLsizei segmentCount = curveCount * (pointsPerTrajectory - 1);
+
+    glDrawArrays(GL_TRIANGLES, 0, segmentCount * 6);
+  }
+
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, 0);
+  glDisable(GL_BLEND);
+  glEnable(GL_CULL_FACE);
+  glBindVertexArray(0);
+  glUseProgram(0);
+}
+
+void TrajectoryRenderer::release() {
+  releaseSystems();
+  if (lineProgram != 0) glDeleteProgram(lineProgram);
+  if (vertexArray != 0) glDeleteVertexArrays(1, &vertexArray);
+  lineProgram = 0;
+  vertexArray = 0;
+}
+
+void TrajectoryRenderer::create() {
+  lineProgram =
+      makeProgram(lineVertexShaderSource.c_str(), lineFragmentShaderSource);
+
+  if (lineProgram == 0)
+    throw SGCError(SGCErrorType::OPENGL_ERROR,
+                   "[OpenGL]: Failed to compile trajectory programs.\n");
+
+  halfWidthUniformLocation = glGetUniformLocation(lineProgram, "halfWidth");
+  colorUniformLocation = glGetUniformLocation(lineProgram, "color");
+
+  glUseProgram(lineProgram);
+  glUniform1i(glGetUniformLocation(lineProgram, "pointCount"),
+              pointsPerTrajectory);
+  glUseProgram(0);
+
+  // Attribute-less draw, vertices are generated from gl_VertexID.
+  glGenVertexArrays(1, &vertexArray);
+}
+
+GLuint TrajectoryRenderer::getPointBuffer(System& system, const View& view) {
+  if (system.seeds.empty()) return 0;
+
+  const float time = system.usesTime ? view.t : 0.0f;
+  const float parameter = system.usesParameter ? view.parameter : 0.0f;
+  useCount++;
+
+  for (auto& integration : system.integrations)
+    if (isSame(integration.time, time) &&
+        isSame(integration.parameter, parameter)) {
+      integration.lastUse = useCount;
+      return integration.pointBuffer;
+    }
+
+  const GLsizeiptr pointsSize =
+      static_cast<GLsizeiptr>(system.seeds.size() / 2 * 2 * 2 *
+                              sizeof(GLfloat)) *
+      pointsPerTrajectory;
+  const std::size_t capacity = static_cast<std::size_t>(
+      std::max<GLsizeiptr>(maxCachedPointBytes / pointsSize, 1));
+
+  // Seeds are uploaded with the first integration after they change.
+  if (system.integrations.empty()) {
+    if (system.seedBuffer == 0) glGenBuffers(1, &system.seedBuffer);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, system.seedBuffer);
+    glBufferData(
+        GL_SHADER_STORAGE_BUFFER,
+        static_cast<GLsizeiptr>(system.seeds.size() * sizeof(GLfloat)),
+        system.seeds.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  }
+
+  Integration* integration = nullptr;
+
+  if (system.integrations.size() < capacity) {
+    integration = &system.integrations.emplace_back();
+
+    glGenBuffers(1, &integration->pointBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, integration->pointBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, pointsSize, nullptr,
+                 GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  } else
+    integration = &*std::min_element(
+        system.integrations.begin(), system.integrations.end(),
+        [](const Integration& a, const Integration& b) {
+          return a.lastUse < b.lastUse;
+        });
+
+  integration->time = time;
+  integration->parameter = parameter;
+  integration->lastUse = useCount;
+  integrate(system, *integration);
+
+  return integration->pointBuffer;
+}
+
+void TrajectoryRenderer::integrate(const System& system,
+                                   const Integration& integration) {
+  const GLsizei seedCount = static_cast<GLsizei>(system.seeds.size() / 2);
+
+  glUseProgram(system.program);
+  glUniform1f(system.timeUniformLocation, integration.time);
+  glUniform1f(system.parameterUniformLocation, integration.parameter);
+  glUniform1i(system.seedCountUniformLocation, seedCount);
+  glUniform1i(system.methodUniformLocation, static_cast<GLint>(system.method));
+
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, system.seedBuffer);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, integration.pointBuffer);
+
+  glDispatchCompute(static_cast<GLuint>((seedCount * 2 + 63) / 64), 1, 1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, 0);
+  glUseProgram(0);
+}
+
+void TrajectoryRenderer::releaseIntegrations(System& system) {
+  for (const auto& integration : system.integrations)
+    glDeleteBuffers(1, &integration.pointBuffer);
+
+  system.integrations.clear();
+}
+
+void TrajectoryRenderer::releaseSystems() {
+  for (auto& system : systems) {
+    glDeleteProgram(system.program);
+    if (system.seedBuffer != 0) glDeleteBuffers(1, &system.seedBuffer);
+    releaseIntegrations(system);
+  }
+
+  systems.clear();
+}
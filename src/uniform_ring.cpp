@@ -0,0 +1,109 @@
+#include <SGC/uniform_ring.hpp>
+#include <cstring>
+
+namespace {
+
+// GL_ARB_buffer_storage is core in 4.4, past the loaded 4.3 functions.
+typedef void(APIENTRYP BufferStorageProc)(GLenum target, GLsizeiptr size,
+                                          const void* data, GLbitfield flags);
+
+constexpr GLbitfield mapPersistentBit = 0x0040;
+constexpr GLbitfield mapCoherentBit = 0x0080;
+
+}  // namespace
+
+UniformRing::~UniformRing() { release(); }
+
+void UniformRing::beginFrame() {
+  if (buffer == 0) create();
+
+  region = (region + 1) % regionCount;
+  offset = 0;
+
+  if (fences[region] != nullptr) {
+    glClientWaitSync(fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000'000);
+    glDeleteSync(fences[region]);
+    fences[region] = nullptr;
+  }
+}
+
+void UniformRing::endFrame() {
+  if (buffer == 0) return;
+
+  if (fences[region] != nullptr) glDeleteSync(fences[region]);
+  fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void UniformRing::push(GLuint binding, const void* data, GLsizeiptr size) {
+  if (buffer == 0) create();
+
+  // A full region restarts once the GPU is done with it, which only happens
+  // with far more draws in a frame than the render paths issue.
+  if (offset + size > regionSize) {
+    glFinish();
+    offset = 0;
+  }
+
+  const GLintptr start = static_cast<GLintptr>(region) * regionSize + offset;
+
+  if (mapping != nullptr) {
+    std::memcpy(mapping + start, data, static_cast<std::size_t>(size));
+  } else {
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, start, size, data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+  }
+
+  glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, start, size);
+
+  offset += (size + offsetAlignment - 1) / offsetAlignment * offsetAlignment;
+}
+
+bool UniformRing::isPersistent() const { return mapping != nullptr; }
+
+void UniformRing::release() {
+  for (auto& fence : fences) {
+    if (fence != nullptr) glDeleteSync(fence);
+    fence = nullptr;
+  }
+
+  if (buffer != 0) {
+    if (mapping != nullptr) {
+      glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+      glUnmapBuffer(GL_UNIFORM_BUFFER);
+      glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    glDeleteBuffers(1, &buffer);
+  }
+
+  buffer = 0;
+  mapping = nullptr;
+  offset = 0;
+}
+
+void UniformRing::create() {
+  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+
+  const GLsizeiptr size = regionSize * regionCount;
+  const auto bufferStorage =
+      glfwExtensionSupported("GL_ARB_buffer_storage")
+          ? reinterpret_cast<BufferStorageProc>(
+                glfwGetProcAddress("glBufferStorage"))
+          : nullptr;
+
+  glGenBuffers(1, &buffer);
+  glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+
+  if (bufferStorage != nullptr) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | mapPersistentBit |
+                             mapCoherentBit;
+    bufferStorage(GL_UNIFORM_BUFFER, size, nullptr, flags);
+    mapping = static_cast<char*>(
+        glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, flags));
+  } else {
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_STREAM_DRAW);
+  }
+
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
@@ -0,0 +1,207 @@
+#include <SGC/camera_block.hpp>
+#include <SGC/shader.hpp>
+#include <SGC/vector_field_renderer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace {
+
+const std::string fieldVertexShaderSourceStart =       //
+    "#version 430 core\n"                              //
+    "#define pi 3.1415927410125732\n"                  //
+    "layout(location = 0) in vec2 corner;" +           //
+    std::string(cameraBlockSource) +                   //
+    "uniform float spacing;"                           //
+    "uniform ivec2 firstCell;"                         //
+    "uniform int columnCount;"                         //
+    "uniform float halfWidth;"                         //
+    "noperspective out vec2 local;"                    //
+    "flat out vec3 arrow;"                             //
+    "bool isEqualApprox(float a, float b, float c) {"  //
+    "  return abs(a - b) <= c * 0.5;"                  //
+    "}"                                                //
+    "vec2 field(vec2 worldPos) {"                      //
+    "  float x = worldPos.x;"                          //
+    "  float y = worldPos.y;"                          //
+    "  float ps = 1.0 / zoom;"                         //
+    "  return vec2(";
+
+// The quad corners are in [-1, 1], local is the fragment position in pixels
+// along and across the arrow, which is centered on its lattice point. arrow
+// holds the length, head length and head half width in pixels.
+const std::string fieldVertexShaderSourceEnd =                             //
+    ");"                                                                   //
+    "}"                                                                    //
+    "void main() {"                                                        //
+    "  ivec2 cell = firstCell + ivec2(gl_InstanceID % columnCount,"        //
+    "    gl_InstanceID / columnCount);"                                    //
+    "  vec2 worldPos = vec2(cell) * spacing;"                              //
+    "  vec2 value = field(worldPos);"                                      //
+    "  float magnitude = length(value);"                                   //
+    "  if (isnan(magnitude) || isinf(magnitude) || magnitude == 0.0) {"    //
+    "    gl_Position = vec4(2.0, 2.0, 2.0, 1.0);"                          //
+    "    local = vec2(0.0);"                                               //
+    "    arrow = vec3(0.0);"                                               //
+    "    return;"                                                          //
+    "  }"                                                                  //
+    "  vec2 direction = value / magnitude;"                                //
+    "  float arrowLength = spacing * zoom * 0.8;"                          //
+    "  float headLength = min(arrowLength * 0.4, halfWidth * 3.0 + 4.0);"  //
+    "  float headHalfWidth = halfWidth * 2.0 + 2.5;"                       //
+    "  arrow = vec3(arrowLength, headLength, headHalfWidth);"              //
+    "  local = corner * vec2(arrowLength * 0.5, headHalfWidth) + corner;"  //
+    "  vec2 center = (worldPos - position) * zoom + windowSize * 0.5;"     //
+    "  vec2 point = center + direction * local.x"                          //
+    "    + vec2(-direction.y, direction.x) * local.y;"                     //
+    "  gl_Position = vec4(point / windowSize * 2.0 - 1.0, 0.0, 1.0);"      //
+    "}";
+
+// Signed pixel distances to the shaft and the head, the arrow is their union.
+const GLchar* fieldFragmentShaderSource =                                   //
+    "#version 430 core\n"                                                   //
+    "noperspective in vec2 local;"                                          //
+    "flat in vec3 arrow;"                                                   //
+    "out vec4 FragColor;"                                                   //
+    "uniform float halfWidth;"                                              //
+    "uniform vec3 color;"                                                   //
+    "void main() {"                                                         //
+    "  vec2 p = vec2(local.x, abs(local.y));"                               //
+    "  float tip = arrow.x * 0.5;"                                          //
+    "  float base = tip - arrow.y;"                                         //
+    "  float shaft = max(p.y - halfWidth, max(-tip - p.x, p.x - base));"    //
+    "  vec2 edgeNormal = normalize(vec2(arrow.z, arrow.y));"                //
+    "  float head = max(base - p.x, dot(p - vec2(tip, 0.0), edgeNormal));"  //
+    "  float coverage = clamp(0.5 - min(shaft, head), 0.0, 1.0);"           //
+    "  if (coverage <= 0.0) discard;"                                       //
+    "  FragColor = vec4(color, coverage);"                                  //
+    "}";
+
+// Smallest 1, 2 or 5 times a power of ten that is at least the value.
+float getLatticePeriod(float minPeriod) {
+  const float decade = std::pow(10.0f, std::floor(std::log10(minPeriod)));
+
+  for (float factor : {1.0f, 2.0f, 5.0f})
+    if (decade * factor >= minPeriod) return decade * factor;
+
+  return decade * 10.0f;
+}
+
+}  // namespace
+
+VectorFieldRenderer::~VectorFieldRenderer() { release(); }
+
+bool VectorFieldRenderer::setGraphs(const std::vector<Graph>& graphs) {
+  std::vector<Field> newFields;
+
+  for (const auto& graph : graphs) {
+    if (!graph.isVisible || graph.type != GraphType::VECTOR_FIELD) continue;
+
+    const std::string vertexSource = fieldVertexShaderSourceStart +
+                                     graph.body + fieldVertexShaderSourceEnd;
+    const GLuint program =
+        makeProgram(vertexSource.c_str(), fieldFragmentShaderSource);
+
+    if (program == 0) {
+      for (const auto& field : newFields) glDeleteProgram(field.program);
+      return false;
+    }
+
+    // Styles are part of the program, the camera comes from the Camera block.
+    glUseProgram(program);
+    glUniform1f(glGetUniformLocation(program, "halfWidth"),
+                std::max(graph.thickness * 0.5f, 0.5f));
+    glUniform3f(glGetUniformLocation(program, "color"), graph.r, graph.g,
+                graph.b);
+    glUseProgram(0);
+
+    Field field;
+    field.program = program;
+    field.spacingUniformLocation = glGetUniformLocation(program, "spacing");
+    field.firstCellUniformLocation = glGetUniformLocation(program, "firstCell");
+    field.columnCountUniformLocation =
+        glGetUniformLocation(program, "columnCount");
+
+    newFields.push_back(field);
+  }
+
+  releaseFields();
+  fields = std::move(newFields);
+
+  return true;
+}
+
+void VectorFieldRenderer::draw(const View& view) {
+  if (fields.empty()) return;
+
+  if (vertexArray == 0) makeGlyph();
+
+  // Lattice points whose arrows can reach the view, an arrow is shorter than
+  // the period.
+  const float spacing = getLatticePeriod(minSpacing / view.zoom);
+  const float halfWidth = static_cast<float>(view.width) * 0.5f / view.zoom;
+  const float halfHeight = static_cast<float>(view.height) * 0.5f / view.zoom;
+  const int firstColumn = static_cast<int>(
+      std::floor((view.positionX - halfWidth) / spacing));
+  const int lastColumn =
+      static_cast<int>(std::ceil((view.positionX + halfWidth) / spacing));
+  const int firstRow = static_cast<int>(
+      std::floor((view.positionY - halfHeight) / spacing));
+  const int lastRow =
+      static_cast<int>(std::ceil((view.positionY + halfHeight) / spacing));
+  const int columnCount = lastColumn - firstColumn + 1;
+  const int rowCount = lastRow - firstRow + 1;
+
+  glBindVertexArray(vertexArray);
+  glDisable(GL_CULL_FACE);
+  glEnable(GL_BLEND);
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                      GL_ONE_MINUS_SRC_ALPHA);
+
+  for (auto field = fields.rbegin(); field != fields.rend(); field++) {
+    glUseProgram(field->program);
+
+    // The lattice also sets the instance count, so it is found on the CPU.
+    glUniform1f(field->spacingUniformLocation, spacing);
+    glUniform2i(field->firstCellUniformLocation, firstColumn, firstRow);
+    glUniform1i(field->columnCountUniformLocation, columnCount);
+
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, columnCount * rowCount);
+  }
+
+  glDisable(GL_BLEND);
+  glEnable(GL_CULL_FACE);
+  glBindVertexArray(0);
+  glUseProgram(0);
+}
+
+void VectorFieldRenderer::release() {
+  releaseFields();
+  if (vertexArray != 0) glDeleteVertexArrays(1, &vertexArray);
+  if (glyphBuffer != 0) glDeleteBuffers(1, &glyphBuffer);
+  vertexArray = 0;
+  glyphBuffer = 0;
+}
+
+void VectorFieldRenderer::makeGlyph() {
+  const GLfloat corners[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f,
+                             -1.0f, 1.0f,  1.0f, -1.0f, 1.0f,  1.0f};
+
+  glGenVertexArrays(1, &vertexArray);
+  glGenBuffers(1, &glyphBuffer);
+
+  glBindVertexArray(vertexArray);
+  glBindBuffer(GL_ARRAY_BUFFER, glyphBuffer);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat),
+                        (void*)0);
+  glEnableVertexAttribArray(0);
+
+  glBindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void VectorFieldRenderer::releaseFields() {
+  for (const auto& field : fields) glDeleteProgram(field.program);
+  fields.clear();
+}
@@ -0,0 +1,48 @@
+#include <SGC/view.hpp>
+#include <cmath>
+
+namespace {
+
+bool isSame(float a, float b) {
+  return !std::isless(a, b) && !std::isgreater(a, b);
+}
+
+float getHalton(int index, int base) {
+  float result = 0.0f;
+  float fraction = 1.0f;
+
+  for (; index > 0; index /= base) {
+    fraction /= static_cast<float>(base);
+    result += fraction * static_cast<float>(index % base);
+  }
+
+  return result;
+}
+
+}  // namespace
+
+void setGridPeriods(View& view, float windowExtent) {
+  view.sublinePeriod = static_cast<float>(
+      std::pow(10.0, std::round(std::log10(windowExtent / view.zoom))));
+  view.microlinePeriod = static_cast<float>(
+      std::pow(10.0, std::round(std::log10(windowExtent / view.zoom / 10.0))));
+}
+
+bool hasSameScale(const View& a, const View& b) {
+  return a.width == b.width && a.height == b.height && isSame(a.zoom, b.zoom) &&
+         isSame(a.sublinePeriod, b.sublinePeriod) &&
+         isSame(a.microlinePeriod, b.microlinePeriod) &&
+         isSame(a.parameter, b.parameter);
+}
+
+bool hasSamePosition(const View& a, const View& b) {
+  return isSame(a.positionX, b.positionX) && isSame(a.positionY, b.positionY);
+}
+
+
+bool hasSameTime(const View& a, const View& b) { return isSame(a.t, b.t); }
+
+void setJitter(View& view, int index) {
+  view.jitterX = getHalton(index + 1, 2) - 0.5f;
+  view.jitterY = getHalton(index + 1, 3) - 0.5f;
+}
\ No newline at end of file
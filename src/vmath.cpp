@@ -0,0 +1,228 @@
+#include <SGC/vmath.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+constexpr float twoOverPi = 0.636619772367581343f;
+constexpr float piOverTwo1 = 1.5703125f;
+constexpr float piOverTwo2 = 4.837512969970703125e-4f;
+constexpr float piOverTwo3 = 7.54978995489188216e-8f;
+constexpr float maxQuadrant = 8388608.0f;
+
+constexpr float log2e = 1.44269504088896341f;
+constexpr float ln2Hi = 0.693359375f;
+constexpr float ln2Lo = -2.12194440e-4f;
+constexpr float sqrtHalf = 0.707106781186547524f;
+
+constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+constexpr float infinity = std::numeric_limits<float>::infinity();
+
+struct Reduced {
+  float sin;
+  float cos;
+  std::uint32_t quadrant;
+};
+
+// Bitwise a or b. Compilers do not turn ternaries with sides that may trap
+// into selects, which keeps the loops from vectorizing.
+inline float select(bool condition, float a, float b) {
+  const std::uint32_t mask = 0u - static_cast<std::uint32_t>(condition);
+  return std::bit_cast<float>((std::bit_cast<std::uint32_t>(a) & mask) |
+                              (std::bit_cast<std::uint32_t>(b) & ~mask));
+}
+
+// |x| = quadrant * pi/2 + r, r in [-pi/4, pi/4], with sin(r) and cos(r).
+inline Reduced reduce(float ax) {
+  const float k = static_cast<float>(static_cast<std::int32_t>(select(
+      ax * twoOverPi < maxQuadrant, ax * twoOverPi + 0.5f, maxQuadrant)));
+  const float r = ((ax - k * piOverTwo1) - k * piOverTwo2) - k * piOverTwo3;
+  const float r2 = r * r;
+
+  const float s =
+      r + r * r2 *
+              (-1.6666654611e-1f +
+               r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+  const float c =
+      1.0f - 0.5f * r2 +
+      r2 * r2 *
+          (4.166664568298827e-2f +
+           r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+  return {s, c, static_cast<std::uint32_t>(k)};
+}
+
+inline float negateIf(float value, bool condition) {
+  return std::bit_cast<float>(std::bit_cast<std::uint32_t>(value) ^
+                              static_cast<std::uint32_t>(condition) << 31);
+}
+
+inline float abs(float value) {
+  return std::bit_cast<float>(std::bit_cast<std::uint32_t>(value) &
+                              0x7FFFFFFFu);
+}
+
+inline bool isNaN(float value) {
+  return (std::bit_cast<std::uint32_t>(value) & 0x7FFFFFFFu) > 0x7F800000u;
+}
+
+inline bool isZero(float value) {
+  return (std::bit_cast<std::uint32_t>(value) & 0x7FFFFFFFu) == 0;
+}
+
+inline float exp2Integer(std::int32_t n) {
+  return std::bit_cast<float>(static_cast<std::uint32_t>(n + 127) << 23);
+}
+
+inline float sinLane(float x) {
+  const Reduced reduced = reduce(abs(x));
+  const float value =
+      select((reduced.quadrant & 1) != 0, reduced.cos, reduced.sin);
+  return negateIf(value, ((reduced.quadrant & 2) != 0) != (x < 0.0f));
+}
+
+inline float cosLane(float x) {
+  const Reduced reduced = reduce(abs(x));
+  const float value =
+      select((reduced.quadrant & 1) != 0, reduced.sin, reduced.cos);
+  return negateIf(value, ((reduced.quadrant + 1) & 2) != 0);
+}
+
+inline float tanLane(float x) {
+  const Reduced reduced = reduce(abs(x));
+  const float value = select((reduced.quadrant & 1) != 0,
+                             -reduced.cos / reduced.sin,
+                             reduced.sin / reduced.cos);
+  return negateIf(value, x < 0.0f);
+}
+
+inline float cotLane(float x) {
+  const Reduced reduced = reduce(abs(x));
+  const float value = select((reduced.quadrant & 1) != 0,
+                             -reduced.sin / reduced.cos,
+                             reduced.cos / reduced.sin);
+  return negateIf(value, x < 0.0f);
+}
+
+inline float expLane(float x) {
+  const float clamped =
+      select(x < -87.3f, -87.3f, select(x > 88.7f, 88.7f, x));
+  const float n = static_cast<float>(static_cast<std::int32_t>(
+      clamped * log2e + select(clamped < 0.0f, -0.5f, 0.5f)));
+  const float r = (clamped - n * ln2Hi) - n * ln2Lo;
+
+  const float p =
+      1.0f + r +
+      r * r *
+          (5.0000001201e-1f +
+           r * (1.6666665459e-1f +
+                r * (4.1665795894e-2f +
+                     r * (8.3334519073e-3f +
+                          r * (1.3981999507e-3f + r * 1.9875691500e-4f)))));
+
+  const std::int32_t exponent = static_cast<std::int32_t>(n);
+  const float value = p * exp2Integer(exponent / 2) *
+                      exp2Integer(exponent - exponent / 2);
+
+  return select(isNaN(x), x,
+                select(x > 88.7f, infinity, select(x < -87.3f, 0.0f, value)));
+}
+
+inline float logLane(float x) {
+  const std::uint32_t bits = std::bit_cast<std::uint32_t>(x);
+  float e = static_cast<float>(static_cast<std::int32_t>(bits >> 23) - 126);
+  float m = std::bit_cast<float>((bits & 0x007FFFFFu) | 0x3F000000u);
+
+  const bool isSmall = m < sqrtHalf;
+  e = select(isSmall, e - 1.0f, e);
+  m = select(isSmall, m + m - 1.0f, m - 1.0f);
+
+  const float z = m * m;
+  float y = 7.0376836292e-2f;
+  y = y * m - 1.1514610310e-1f;
+  y = y * m + 1.1676998740e-1f;
+  y = y * m - 1.2420140846e-1f;
+  y = y * m + 1.4249322787e-1f;
+  y = y * m - 1.6668057665e-1f;
+  y = y * m + 2.0000714765e-1f;
+  y = y * m - 2.4999993993e-1f;
+  y = y * m + 3.3333331174e-1f;
+  y *= z * m;
+  y += e * ln2Lo;
+  y -= 0.5f * z;
+  const float value = m + y + e * ln2Hi;
+
+  return select(x > 0.0f, select(x < infinity, value, x),
+                select((x < 0.0f) | isNaN(x), nan, -infinity));
+}
+
+// Sign and special cases of a^b, value is exp(b * log(|a|)). Exponents from
+// 2^24 on are even integers in fp32, smaller ones fit int32.
+inline float powSign(float a, float b, float value) {
+  const bool isSmall = abs(b) < 1.6777216e7f;
+  const float small = select(isSmall, b, 0.0f);
+  const std::int32_t integer = static_cast<std::int32_t>(small);
+  const float rounded = static_cast<float>(integer);
+  const bool isInteger =
+      (!isSmall) | (!(rounded < small) & !(rounded > small));
+  // Parity as a float compare keeps all conditions 32 bits wide, so the loop
+  // still vectorizes.
+  const bool isOdd = isSmall & (static_cast<float>(integer & 1) > 0.5f);
+
+  const float negative = select(isInteger, negateIf(value, isOdd), nan);
+  const float result = select(a < 0.0f, negative, value);
+
+  return select(isZero(b), 1.0f,
+                select(isZero(a), select(b > 0.0f, 0.0f, infinity), result));
+}
+
+}  // namespace
+
+namespace vmath {
+
+void sin(float* values, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) values[i] = sinLane(values[i]);
+}
+
+void cos(float* values, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) values[i] = cosLane(values[i]);
+}
+
+void tan(float* values, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) values[i] = tanLane(values[i]);
+}
+
+void cot(float* values, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) values[i] = cotLane(values[i]);
+}
+
+void exp(float* values, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) values[i] = expLane(values[i]);
+}
+
+void log(float* values, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) values[i] = logLane(values[i]);
+}
+
+// In blocks of three short loops, one loop with log and exp inlined runs out
+// of vector registers and spills.
+void pow(float* bases, const float* exponents, std::size_t count) {
+  constexpr std::size_t blockSize = 64;
+  float values[blockSize];
+
+  for (std::size_t offset = 0; offset < count; offset += blockSize) {
+    const std::size_t size = std::min(blockSize, count - offset);
+    float* a = bases + offset;
+    const float* b = exponents + offset;
+
+    for (std::size_t i = 0; i < size; i++)
+      values[i] = b[i] * logLane(abs(a[i]));
+    for (std::size_t i = 0; i < size; i++) values[i] = expLane(values[i]);
+    for (std::size_t i = 0; i < size; i++)
+      a[i] = powSign(a[i], b[i], values[i]);
+  }
+}
+
+}  // namespace vmath
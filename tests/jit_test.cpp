@@ -0,0 +1,158 @@
+#include <SGC/expression.hpp>
+#include <SGC/jit.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+// Checks compiled expressions against the batch interpreter. The count is not
+// a multiple of the lane or batch size, so partial batches are covered too.
+
+namespace {
+
+constexpr std::size_t sampleCount = 1003;
+constexpr std::size_t registerCount = 14;
+
+int failureCount = 0;
+
+std::set<OpCode> coveredOps;
+
+// Values on a quarter grid, so equality comparisons are true for some lanes.
+std::vector<float> makeInputs(float from, float step) {
+  std::vector<float> inputs(sampleCount);
+
+  for (std::size_t i = 0; i < sampleCount; i++)
+    inputs[i] = from + step * static_cast<float>(i % 97);
+
+  return inputs;
+}
+
+// NaN matches NaN, calls into vmath may round differently in the last bits.
+bool isMatch(float value, float expected) {
+  if (std::isnan(expected)) return std::isnan(value);
+  if (std::isinf(expected)) return !(value < expected) && !(value > expected);
+
+  const float bound = 1e-6f * std::max(1.0f, std::abs(expected));
+  return std::abs(value - expected) <= bound;
+}
+
+void check(const std::string& source, bool isNativeExpected) {
+  const std::vector<float> x = makeInputs(-6.0f, 0.25f);
+  const std::vector<float> y = makeInputs(-3.0f, 0.125f);
+  const EvaluationInput input{x.data(), y.data(), 0.01f, 1.5f, sampleCount};
+
+  const Expression expression(source);
+  for (const auto& instruction : expression.getInstructions())
+    coveredOps.insert(instruction.op);
+
+  std::vector<float> expected(sampleCount);
+  expression.evaluate(input, expected.data());
+
+  const CompiledExpression compiled(expression);
+  std::vector<float> values(sampleCount);
+  compiled.evaluate(input, values.data());
+
+  std::size_t mismatchCount = 0;
+  std::size_t firstMismatch = 0;
+
+  for (std::size_t i = 0; i < sampleCount; i++) {
+    if (isMatch(values[i], expected[i])) continue;
+    if (mismatchCount++ == 0) firstMismatch = i;
+  }
+
+  const bool isNativeMatched = compiled.isNative() == isNativeExpected;
+  const bool isPassed = mismatchCount == 0 && isNativeMatched;
+  if (!isPassed) failureCount++;
+
+  std::printf("%-5s %s %s depth %zu", isPassed ? "ok" : "FAIL",
+              compiled.isNative() ? "native" : "interpreted",
+              source.c_str(), expression.getMaxStackDepth());
+  if (mismatchCount > 0)
+    std::printf(", %zu mismatches, %g instead of %g at x = %g, y = %g",
+                mismatchCount, static_cast<double>(values[firstMismatch]),
+                static_cast<double>(expected[firstMismatch]),
+                static_cast<double>(x[firstMismatch]),
+                static_cast<double>(y[firstMismatch]));
+  std::printf("\n");
+}
+
+// Sum of depth - 1 leading terms around the last, which is evaluated with
+// those terms on the stack.
+std::string makeNested(std::size_t depth, const std::string& last) {
+  const char* terms[] = {"x", "y", "ps", "t"};
+  std::string source;
+
+  for (std::size_t i = 0; i + 1 < depth; i++)
+    source += std::string(terms[i % 4]) + " + (";
+  source += last;
+  source += std::string(depth - 1, ')');
+
+  return source;
+}
+
+}  // namespace
+
+int main() {
+  // Native code needs AVX2, without it every expression is interpreted.
+  const bool isNativeSupported =
+      CompiledExpression(Expression("x")).isNative();
+  if (!isNativeSupported)
+    std::printf("note  AVX2 is not available, checking the fallback only\n");
+
+  const char* sources[] = {
+      "x",
+      "y",
+      "ps",
+      "t",
+      "1.5",
+      "pi",
+      "x + y",
+      "x - y",
+      "x * y",
+      "x / y",
+      "-x",
+      "!(x < y)",
+      "x < 0 && y > 0",
+      "x < 0 || y > 0",
+      "x < y",
+      "x <= y",
+      "x > y",
+      "x >= y",
+      "x == y",
+      "x != y",
+      "abs(x)",
+      "sqrt(x)",
+      "sin(x)",
+      "cos(x)",
+      "tan(x)",
+      "cot(x)",
+      "exp(x)",
+      "log(x)",
+      "pow(x, y)",
+      "isEqualApprox(x, y, 0.5)",
+      "isEqualApprox(y, sin(x) * 2.0 + t, ps * 20.0)",
+      "sqrt(x * x + y * y) < 3.0 || pow(abs(x), 1.5) == y",
+  };
+
+  for (const char* source : sources) check(source, isNativeSupported);
+
+  for (int op = 0; op <= static_cast<int>(OpCode::IS_EQUAL_APPROX); op++) {
+    if (coveredOps.count(static_cast<OpCode>(op)) != 0) continue;
+    std::printf("FAIL  opcode %d is not covered\n", op);
+    failureCount++;
+  }
+
+  // Calls spill every live register and reload them after.
+  for (std::size_t depth = 1; depth <= registerCount; depth++)
+    check(makeNested(depth, "sin(x)"), isNativeSupported);
+  for (std::size_t depth = 1; depth < registerCount; depth++)
+    check(makeNested(depth, "pow(x, y)"), isNativeSupported);
+
+  // Deeper expressions do not fit the registers and are interpreted.
+  check(makeNested(registerCount + 1, "x"), false);
+  check(makeNested(registerCount, "pow(x, y)"), false);
+
+  return failureCount == 0 ? 0 : 1;
+}
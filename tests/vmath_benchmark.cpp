@@ -0,0 +1,88 @@
+#include <SGC/vmath.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Throughput of vmath against scalar libm calls, in nanoseconds per value.
+// Only meaningful in an optimized build, the loops vectorize from -O3 on.
+// With GCC 12 and glibc at -O3 for baseline x86-64, sin and cos run about 2x
+// libm, tan and cot 4-6x, exp and log 1.3-1.5x and pow 1.0-1.2x. With -mavx2
+// pow reaches 2-2.8x. At -O2 nothing vectorizes and vmath is 2-5x slower.
+
+namespace {
+
+constexpr std::size_t valueCount = 1 << 16;
+constexpr int repeatCount = 200;
+
+template <typename Function>
+double measure(std::vector<float>& values, const std::vector<float>& inputs,
+               Function function) {
+  double best = 1e30;
+
+  // The best of a few rounds hides scheduling noise.
+  for (int round = 0; round < 5; round++) {
+    const auto begin = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < repeatCount; i++) {
+      values = inputs;
+      function(values.data(), values.size());
+    }
+
+    const std::chrono::duration<double, std::nano> time =
+        std::chrono::steady_clock::now() - begin;
+    best = std::min(best, time.count() / (repeatCount * valueCount));
+  }
+
+  return best;
+}
+
+volatile float sink;
+
+template <typename Function, typename Reference>
+void benchmark(const char* name, float from, float to, Function function,
+               Reference reference) {
+  std::vector<float> inputs(valueCount);
+  for (std::size_t i = 0; i < valueCount; i++)
+    inputs[i] = from + (to - from) * static_cast<float>(i) /
+                           static_cast<float>(valueCount);
+
+  std::vector<float> values;
+  const double vmathTime = measure(values, inputs, function);
+  sink = values[valueCount / 2];
+
+  const double libmTime =
+      measure(values, inputs, [&](float* data, std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) data[i] = reference(data[i]);
+      });
+  sink = values[valueCount / 2];
+
+  std::printf("%-4s vmath %6.2f ns, libm %6.2f ns, %5.2fx\n", name, vmathTime,
+              libmTime, libmTime / vmathTime);
+}
+
+}  // namespace
+
+int main() {
+  benchmark("sin", -100.0f, 100.0f, vmath::sin,
+            [](float x) { return std::sin(x); });
+  benchmark("cos", -100.0f, 100.0f, vmath::cos,
+            [](float x) { return std::cos(x); });
+  benchmark("tan", -1.5f, 1.5f, vmath::tan,
+            [](float x) { return std::tan(x); });
+  benchmark("cot", 0.05f, 3.1f, vmath::cot,
+            [](float x) { return 1.0f / std::tan(x); });
+  benchmark("exp", -80.0f, 80.0f, vmath::exp,
+            [](float x) { return std::exp(x); });
+  benchmark("log", 1e-3f, 1e3f, vmath::log,
+            [](float x) { return std::log(x); });
+
+  const std::vector<float> exponents(valueCount, 2.5f);
+  benchmark(
+      "pow", 0.01f, 100.0f,
+      [&](float* data, std::size_t count) {
+        vmath::pow(data, exponents.data(), count);
+      },
+      [](float x) { return std::pow(x, 2.5f); });
+}
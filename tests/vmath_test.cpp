@@ -0,0 +1,134 @@
+#include <SGC/vmath.hpp>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+// Checks vmath against libm in double precision over the ranges documented in
+// vmath.hpp. Inputs are evenly spaced and include both ends.
+
+namespace {
+
+constexpr std::size_t sampleCount = 1 << 20;
+
+int failureCount = 0;
+
+std::vector<float> makeInputs(float from, float to) {
+  std::vector<float> inputs(sampleCount);
+
+  for (std::size_t i = 0; i < sampleCount; i++)
+    inputs[i] = static_cast<float>(
+        from + (static_cast<double>(to) - from) * static_cast<double>(i) /
+                   static_cast<double>(sampleCount - 1));
+
+  return inputs;
+}
+
+// Error of every value against the reference, absolute or relative to it.
+void check(const char* name, const std::vector<float>& inputs,
+           const std::vector<float>& values,
+           const std::function<double(double)>& reference, bool isRelative,
+           double bound) {
+  double maxError = 0.0;
+  float worstInput = 0.0f;
+
+  for (std::size_t i = 0; i < inputs.size(); i++) {
+    const double expected = reference(static_cast<double>(inputs[i]));
+    const double difference =
+        std::abs(static_cast<double>(values[i]) - expected);
+    const double error =
+        isRelative ? difference / std::abs(expected) : difference;
+
+    if (!(error <= maxError)) {
+      maxError = error;
+      worstInput = inputs[i];
+    }
+  }
+
+  const bool isPassed = maxError <= bound;
+  if (!isPassed) failureCount++;
+
+  std::printf("%-5s %s %s error %.3g at %.9g (bound %.3g)\n",
+              isPassed ? "ok" : "FAIL", name,
+              isRelative ? "relative" : "absolute", maxError,
+              static_cast<double>(worstInput), bound);
+}
+
+void checkUnary(const char* name, void (*function)(float*, std::size_t),
+                double (*reference)(double), float from, float to,
+                bool isRelative, double bound) {
+  const std::vector<float> inputs = makeInputs(from, to);
+  std::vector<float> values = inputs;
+  function(values.data(), values.size());
+  check(name, inputs, values, reference, isRelative, bound);
+}
+
+// Special values are compared exactly, NaN to NaN.
+void checkSpecial(const char* name, float value, float expected) {
+  const bool isPassed = std::isnan(expected)
+                            ? std::isnan(value)
+                            : !(value < expected) && !(value > expected);
+  if (!isPassed) failureCount++;
+
+  std::printf("%-5s %s = %g (expected %g)\n", isPassed ? "ok" : "FAIL", name,
+              static_cast<double>(value), static_cast<double>(expected));
+}
+
+float apply(void (*function)(float*, std::size_t), float x) {
+  function(&x, 1);
+  return x;
+}
+
+float applyPow(float a, float b) {
+  vmath::pow(&a, &b, 1);
+  return a;
+}
+
+double cot(double x) { return 1.0 / std::tan(x); }
+
+}  // namespace
+
+int main() {
+  checkUnary("sin", vmath::sin, std::sin, -1e4f, 1e4f, false, 1e-6);
+  checkUnary("cos", vmath::cos, std::cos, -1e4f, 1e4f, false, 1e-6);
+  checkUnary("tan", vmath::tan, std::tan, -1.5f, 1.5f, true, 1e-6);
+  checkUnary("cot", vmath::cot, cot, 0.05f, 3.1f, true, 1e-6);
+  checkUnary("exp", vmath::exp, std::exp, -87.0f, 88.0f, true, 1e-6);
+  checkUnary("log", vmath::log, std::log, 1.2e-38f, 3e38f, true, 1e-6);
+  checkUnary("log", vmath::log, std::log, 0.5f, 2.0f, false, 1e-7);
+
+  // pow follows exp(b * log(|a|)), so the error grows with |b * log(a)|.
+  {
+    const std::vector<float> bases = makeInputs(0.01f, 100.0f);
+    for (float exponent : {-3.0f, -0.5f, 0.5f, 2.0f, 7.0f}) {
+      std::vector<float> values = bases;
+      const std::vector<float> exponents(bases.size(), exponent);
+      vmath::pow(values.data(), exponents.data(), values.size());
+
+      char name[32];
+      std::snprintf(name, sizeof(name), "pow(a, %g)",
+                    static_cast<double>(exponent));
+      check(name, bases, values,
+            [exponent](double a) {
+              return std::pow(a, static_cast<double>(exponent));
+            },
+            true, 1e-5);
+    }
+  }
+
+  const float nan = std::nanf("");
+  const float infinity = INFINITY;
+
+  checkSpecial("exp(-inf)", apply(vmath::exp, -infinity), 0.0f);
+  checkSpecial("exp(inf)", apply(vmath::exp, infinity), infinity);
+  checkSpecial("exp(nan)", apply(vmath::exp, nan), nan);
+  checkSpecial("log(0)", apply(vmath::log, 0.0f), -infinity);
+  checkSpecial("log(-1)", apply(vmath::log, -1.0f), nan);
+  checkSpecial("log(inf)", apply(vmath::log, infinity), infinity);
+  checkSpecial("pow(-2, 3)", applyPow(-2.0f, 3.0f), -8.0f);
+  checkSpecial("pow(-2, 0.5)", applyPow(-2.0f, 0.5f), nan);
+  checkSpecial("pow(0, -1)", applyPow(0.0f, -1.0f), infinity);
+  checkSpecial("pow(5, 0)", applyPow(5.0f, 0.0f), 1.0f);
+
+  return failureCount == 0 ? 0 : 1;
+}